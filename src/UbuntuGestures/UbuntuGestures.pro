@@ -14,7 +14,8 @@ HEADERS += \
     $$PWD/ubuntugesturesmodule.h \
     $$PWD/ucswipearea_p.h \
     $$PWD/ucswipearea_p_p.h \
-    $$PWD/unownedtouchevent_p.h
+    $$PWD/unownedtouchevent_p.h \
+    $$PWD/velocityestimator_p.h
 
 SOURCES += \
     $$PWD/candidateinactivitytimer.cpp \
@@ -26,6 +27,7 @@ SOURCES += \
     $$PWD/touchregistry.cpp \
     $$PWD/ubuntugesturesmodule.cpp \
     $$PWD/ucswipearea.cpp \
-    $$PWD/unownedtouchevent.cpp
+    $$PWD/unownedtouchevent.cpp \
+    $$PWD/velocityestimator.cpp
 
 load(ubuntu_qt_module)
@@ -18,6 +18,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtQuick/QQuickWindow>
 #include <QtQuick/private/qquickitem_p.h>
 
 #include "candidateinactivitytimer_p.h"
@@ -37,6 +38,7 @@ TouchRegistry *TouchRegistry::m_instance = nullptr;
 TouchRegistry::TouchRegistry(QObject *parent)
     : QObject(parent)
     , m_inDispatchLoop(false)
+    , m_coalesceUpdates(qEnvironmentVariableIsSet("UBUNTU_GESTURES_COALESCE_TOUCH"))
     , m_timerFactory(new TimerFactory)
 {
 }
@@ -62,10 +64,31 @@ void TouchRegistry::setTimerFactory(AbstractTimerFactory *timerFactory)
     m_timerFactory = timerFactory;
 }
 
+void TouchRegistry::setCoalesceUpdates(bool enabled)
+{
+    if (m_coalesceUpdates == enabled) {
+        return;
+    }
+
+    if (!enabled) {
+        flushPendingUpdates();
+    }
+    m_coalesceUpdates = enabled;
+}
+
 void TouchRegistry::update(const QTouchEvent *event)
 {
     UG_DEBUG << "got" << qPrintable(touchEventToString(event));
 
+    if (m_coalesceUpdates) {
+        if (canCoalesce(event)) {
+            coalesceUpdate(event);
+            return;
+        }
+        // presses and releases must not overtake the updates that came before them
+        flushPendingUpdates();
+    }
+
     const QList<QTouchEvent::TouchPoint> &touchPoints = event->touchPoints();
     for (int i = 0; i < touchPoints.count(); ++i) {
         const QTouchEvent::TouchPoint &touchPoint = touchPoints.at(i);
@@ -88,7 +111,104 @@ void TouchRegistry::update(const QTouchEvent *event)
     freeEndedTouchInfos();
 }
 
-void TouchRegistry::deliverTouchUpdatesToUndecidedCandidatesAndWatchers(const QTouchEvent *event)
+bool TouchRegistry::canCoalesce(const QTouchEvent *event) const
+{
+    return event->type() == QEvent::TouchUpdate
+        && !(event->touchPointStates() & (Qt::TouchPointPressed | Qt::TouchPointReleased));
+}
+
+/*
+   Merges the given TouchUpdate into m_pendingUpdate, recording the positions of its
+   touch points in m_pendingHistory.
+ */
+void TouchRegistry::coalesceUpdate(const QTouchEvent *event)
+{
+    const QList<QTouchEvent::TouchPoint> &touchPoints = event->touchPoints();
+
+    if (m_pendingUpdate.isNull()) {
+        m_pendingUpdate.reset(new QTouchEvent(event->type(),
+                                              event->device(),
+                                              event->modifiers(),
+                                              event->touchPointStates(),
+                                              touchPoints));
+        m_pendingUpdate->setWindow(event->window());
+        m_pendingUpdate->setTarget(event->target());
+
+        // Make sure there will be a frame boundary to flush it at.
+        QQuickWindow *window = qobject_cast<QQuickWindow*>(event->window());
+        if (window) {
+            connect(window, &QQuickWindow::afterAnimating,
+                    this, &TouchRegistry::flushPendingUpdates, Qt::UniqueConnection);
+            window->update();
+        }
+    } else {
+        QList<QTouchEvent::TouchPoint> mergedTouchPoints = m_pendingUpdate->touchPoints();
+        for (int i = 0; i < touchPoints.count(); ++i) {
+            const QTouchEvent::TouchPoint &touchPoint = touchPoints.at(i);
+
+            int mergedIndex = -1;
+            for (int j = 0; j < mergedTouchPoints.count() && mergedIndex == -1; ++j) {
+                if (mergedTouchPoints.at(j).id() == touchPoint.id()) {
+                    mergedIndex = j;
+                }
+            }
+
+            if (mergedIndex == -1) {
+                mergedTouchPoints.append(touchPoint);
+            } else {
+                // The merged point moves from where it was before the first coalesced update
+                const QTouchEvent::TouchPoint &previous = mergedTouchPoints.at(mergedIndex);
+                QTouchEvent::TouchPoint merged = touchPoint;
+                merged.setLastPos(previous.lastPos());
+                merged.setLastScenePos(previous.lastScenePos());
+                merged.setLastScreenPos(previous.lastScreenPos());
+                if (previous.state() == Qt::TouchPointMoved) {
+                    merged.setState(Qt::TouchPointMoved);
+                }
+                mergedTouchPoints[mergedIndex] = merged;
+            }
+        }
+
+        Qt::TouchPointStates mergedStates = 0;
+        for (int i = 0; i < mergedTouchPoints.count(); ++i) {
+            mergedStates |= mergedTouchPoints.at(i).state();
+        }
+
+        m_pendingUpdate->setTouchPoints(mergedTouchPoints);
+        m_pendingUpdate->setTouchPointStates(mergedStates);
+        m_pendingUpdate->setModifiers(event->modifiers());
+    }
+    m_pendingUpdate->setTimestamp(event->timestamp());
+
+    // pos() is what dispatchPointsToItem() will turn into the scene position
+    for (int i = 0; i < touchPoints.count(); ++i) {
+        TouchHistoryPoint historyPoint;
+        historyPoint.scenePos = touchPoints.at(i).pos();
+        historyPoint.timestamp = event->timestamp();
+        m_pendingHistory[touchPoints.at(i).id()].append(historyPoint);
+    }
+
+    UG_DEBUG << "coalesced into" << qPrintable(touchEventToString(m_pendingUpdate.data()));
+}
+
+void TouchRegistry::flushPendingUpdates()
+{
+    if (m_pendingUpdate.isNull()) {
+        return;
+    }
+
+    // Take them out first as recipients might call back into us
+    QScopedPointer<QTouchEvent> event(m_pendingUpdate.take());
+    QHash<int, TouchHistory> history;
+    history.swap(m_pendingHistory);
+
+    deliverTouchUpdatesToUndecidedCandidatesAndWatchers(event.data(), history);
+
+    freeEndedTouchInfos();
+}
+
+void TouchRegistry::deliverTouchUpdatesToUndecidedCandidatesAndWatchers(const QTouchEvent *event,
+        const QHash<int, TouchHistory> &history)
 {
     // TODO: Look into how we could optimize this whole thing.
     //       Although it's not really a problem as we should have at most two candidates
@@ -141,7 +261,7 @@ void TouchRegistry::deliverTouchUpdatesToUndecidedCandidatesAndWatchers(const QT
     while (it != touchIdsForItems.constEnd()) {
         QQuickItem *item = it.key();
         const QList<int> &touchIds = it.value();
-        dispatchPointsToItem(event, touchIds, item);
+        dispatchPointsToItem(event, touchIds, item, history);
         ++it;
     };
     m_inDispatchLoop = false;
@@ -162,7 +282,7 @@ void TouchRegistry::freeEndedTouchInfos()
    UnownedTouchEvent to the given item
  */
 void TouchRegistry::dispatchPointsToItem(const QTouchEvent *event, const QList<int> &touchIds,
-        QQuickItem *item)
+        QQuickItem *item, const QHash<int, TouchHistory> &history)
 {
     Qt::TouchPointStates touchPointStates = 0;
     QList<QTouchEvent::TouchPoint> touchPoints;
@@ -201,6 +321,17 @@ void TouchRegistry::dispatchPointsToItem(const QTouchEvent *event, const QList<i
 
     UnownedTouchEvent unownedTouchEvent(eventForItem);
 
+    if (!history.isEmpty()) {
+        QHash<int, TouchHistory> historyForItem;
+        for (int i = 0; i < touchIds.count(); ++i) {
+            auto it = history.constFind(touchIds[i]);
+            if (it != history.constEnd()) {
+                historyForItem.insert(it.key(), it.value());
+            }
+        }
+        unownedTouchEvent.setHistory(historyForItem);
+    }
+
     UG_DEBUG << "Sending unowned" << qPrintable(touchEventToString(eventForItem))
         << "to" << item;
 
@@ -17,9 +17,11 @@
 #ifndef TOUCHREGISTRY_P_H
 #define TOUCHREGISTRY_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QVector>
 #include <QtGui/QTouchEvent>
 #include <QtQuick/QQuickItem>
@@ -28,6 +30,7 @@
 #include <UbuntuGestures/private/candidateinactivitytimer_p.h>
 #include <UbuntuGestures/private/timer_p.h>
 #include <UbuntuGestures/private/pool_p.h>
+#include <UbuntuGestures/private/unownedtouchevent_p.h>
 
 UG_FORWARD_DECLARE_CLASS(AbstractTimerFactory)
 
@@ -87,6 +90,16 @@ UG_FORWARD_DECLARE_CLASS(AbstractTimerFactory)
 
   Items oblivious to TouchRegistry will lose their touch points without warning, just like in plain Qt.
 
+  Touch update coalescing:
+
+  A touch screen can produce several TouchUpdates per frame, and each of them would otherwise
+  be immediately dispatched as an UnownedTouchEvent to every undecided candidate and watcher.
+  Once setCoalesceUpdates(true) is called, TouchUpdates that neither press nor release a touch
+  point are merged per touch id and delivered as a single UnownedTouchEvent right before the
+  window animates its next frame, or before the next press or release, whichever comes first.
+  The positions each touch point went through meanwhile are kept in UnownedTouchEvent::history()
+  so that recipients can still compute velocities or replay the movement.
+
   [1] - http://www.x.org/releases/X11R7.7/doc/inputproto/XI2proto.txt (see multitouch-ownership)
  */
 
@@ -129,6 +142,16 @@ public:
     // Useful for tests, where you should use fake timers
     void setTimerFactory(AbstractTimerFactory *timerFactory);
 
+    // Whether consecutive TouchUpdates get merged before being dispatched to undecided
+    // candidates and watchers. Disabled by default, unless the UBUNTU_GESTURES_COALESCE_TOUCH
+    // environment variable is set.
+    void setCoalesceUpdates(bool enabled);
+    bool coalesceUpdates() const { return m_coalesceUpdates; }
+
+public Q_SLOTS:
+    // Dispatches the coalesced TouchUpdate, if any.
+    void flushPendingUpdates();
+
 private Q_SLOTS:
     void rejectCandidateOwnerForTouch(int id, QQuickItem *candidate);
 
@@ -179,12 +202,16 @@ private:
 
     Pool<TouchInfo>::Iterator findTouchInfo(int id);
 
-    void deliverTouchUpdatesToUndecidedCandidatesAndWatchers(const QTouchEvent *event);
+    void deliverTouchUpdatesToUndecidedCandidatesAndWatchers(const QTouchEvent *event,
+            const QHash<int, TouchHistory> &history = QHash<int, TouchHistory>());
+
+    bool canCoalesce(const QTouchEvent *event) const;
+    void coalesceUpdate(const QTouchEvent *event);
 
     static void translateTouchPointFromScreenToWindowCoords(QTouchEvent::TouchPoint &touchPoint);
 
     static void dispatchPointsToItem(const QTouchEvent *event, const QList<int> &touchIds,
-                                     QQuickItem *item);
+                                     QQuickItem *item, const QHash<int, TouchHistory> &history);
     void freeEndedTouchInfos();
 
     Pool<TouchInfo> m_touchInfoPool;
@@ -193,9 +220,15 @@ private:
     static TouchRegistry *m_instance;
 
     bool m_inDispatchLoop;
+    bool m_coalesceUpdates;
 
     AbstractTimerFactory *m_timerFactory;
 
+    // The merged TouchUpdate waiting to be dispatched and the positions its
+    // touch points went through, by touch id.
+    QScopedPointer<QTouchEvent> m_pendingUpdate;
+    QHash<int, TouchHistory> m_pendingHistory;
+
     friend class tst_TouchRegistry;
     friend class tst_DirectionalDragArea;
 };
@@ -242,6 +242,16 @@ void UCSwipeAreaPrivate::setCompositionTime(int value)
     compositionTime = value;
 }
 
+void UCSwipeAreaPrivate::setEarlyRecognitionSpeed(qreal value)
+{
+    earlyRecognitionSpeed = value;
+}
+
+void UCSwipeAreaPrivate::setEarlyRecognitionConfidence(qreal value)
+{
+    earlyRecognitionConfidence = value;
+}
+
 void UCSwipeAreaPrivate::setMaxTime(int value)
 {
     if (maxTime != value) {
@@ -295,6 +305,20 @@ qreal UCSwipeArea::distance() const
     return d->sceneDistance;
 }
 
+/*!
+ * \qmlproperty real SwipeArea::velocity
+ * \readonly
+ * The property holds the velocity of the touch point performing the swipe along
+ * the swipe \l direction, in pixels per second. It keeps its last value once the
+ * touch point is released, until a new one lands on the area, so it can be used
+ * to decide whether a swipe ended with a flick.
+ */
+qreal UCSwipeArea::velocity() const
+{
+    Q_D(const UCSwipeArea);
+    return d->sceneVelocity;
+}
+
 /*!
  * \qmlproperty point SwipeArea::touchPosition
  * \readonly
@@ -382,6 +406,33 @@ void UCSwipeArea::setGrabGesture(bool enabled)
     Q_EMIT grabGestureChanged(enabled);
 }
 
+/*!
+ * \qmlproperty bool SwipeArea::earlyRecognition
+ * If true, a quick swipe is recognized before it crosses the distance threshold,
+ * as soon as the composition time is over. The touch must move at least 50mm/s
+ * and mostly along the \l direction of the area.
+ *
+ * Defaults to false, in which case gestures are recognized by distance only.
+ */
+bool UCSwipeArea::earlyRecognition() const
+{
+    Q_D(const UCSwipeArea);
+    return d->earlyRecognition;
+}
+
+void UCSwipeArea::setEarlyRecognition(bool enabled)
+{
+    Q_D(UCSwipeArea);
+    if (d->earlyRecognition == enabled) {
+        return;
+    }
+
+    d->earlyRecognition = enabled;
+    d->setEarlyRecognitionSpeed(enabled ? 50. * d->pixelsPerMm : 0.);
+
+    Q_EMIT earlyRecognitionChanged(enabled);
+}
+
 bool UCSwipeArea::event(QEvent *event)
 {
     Q_D(UCSwipeArea);
@@ -456,6 +507,17 @@ void UCSwipeAreaPrivate::unownedTouchEvent_undecided(UnownedTouchEvent *unownedT
 
     const QPointF &touchScenePosition = touchPoint->scenePos();
 
+    // Positions TouchRegistry might have coalesced into this event, if any.
+    // Their timestamps are only meaningful relative to each other.
+    const TouchHistory history = unownedTouchEvent->history(touchId);
+    const qint64 now = timeSource->msecsSinceReference();
+    for (int i = 0; i < history.count() - 1; ++i) {
+        addVelocitySample(history[i].scenePos,
+                          now - (qint64)(history.last().timestamp - history[i].timestamp));
+    }
+    addVelocitySample(touchScenePosition, now);
+    updateVelocity();
+
     if (touchPoint->state() == Qt::TouchPointReleased) {
         // touch has ended before recognition concluded
         SA_TRACE("Touch has ended before recognition concluded");
@@ -464,11 +526,19 @@ void UCSwipeAreaPrivate::unownedTouchEvent_undecided(UnownedTouchEvent *unownedT
         return;
     }
 
-    previousDampedScenePos.setX(dampedScenePos.x());
-    previousDampedScenePos.setY(dampedScenePos.y());
-    dampedScenePos.update(touchScenePosition);
+    // Replay the coalesced positions so that damping and direction checks
+    // see the same movement they would otherwise.
+    bool rightDirection = true;
+    for (int i = 0; i < history.count() - 1 && rightDirection; ++i) {
+        updateDampedScenePos(history[i].scenePos);
+        rightDirection = movingInRightDirection();
+    }
+    if (rightDirection) {
+        updateDampedScenePos(touchScenePosition);
+        rightDirection = movingInRightDirection();
+    }
 
-    if (!movingInRightDirection()) {
+    if (!rightDirection) {
         SA_TRACE("Rejecting gesture because touch point is moving in the wrong direction.");
         TouchRegistry::instance()->removeCandidateOwnerForTouch(touchId, q);
         // We still wanna know when it ends for keeping the composition time window up-to-date
@@ -484,7 +554,7 @@ void UCSwipeAreaPrivate::unownedTouchEvent_undecided(UnownedTouchEvent *unownedT
         return;
     }
 
-    if (movedFarEnoughAlongGestureAxis()) {
+    if (movedFarEnoughAlongGestureAxis() || movingFastEnoughAlongGestureAxis()) {
         if (grabGesture) {
             TouchRegistry::instance()->requestTouchOwnership(touchId, q);
         }
@@ -582,6 +652,7 @@ void UCSwipeAreaPrivate::touchEvent_absent(QTouchEvent *event)
         updatePosition(startScenePos);
 
         updateSceneDirectionVector();
+        resetVelocity(startScenePos);
 
         if (recognitionIsDisabled()) {
             // Behave like a dumb TouchArea
@@ -647,6 +718,8 @@ void UCSwipeAreaPrivate::touchEvent_recognized(QTouchEvent *event)
         setStatus(WaitingForTouch);
     } else {
         updatePosition(touchPoint->scenePos());
+        addVelocitySample(touchPoint->scenePos(), timeSource->msecsSinceReference());
+        updateVelocity();
 
         if (touchPoint->state() == Qt::TouchPointReleased) {
             setStatus(WaitingForTouch);
@@ -689,6 +762,13 @@ const QTouchEvent::TouchPoint *UCSwipeAreaPrivate::fetchTargetTouchPoint(QTouchE
     return touchPoint;
 }
 
+void UCSwipeAreaPrivate::updateDampedScenePos(const QPointF &point)
+{
+    previousDampedScenePos.setX(dampedScenePos.x());
+    previousDampedScenePos.setY(dampedScenePos.y());
+    dampedScenePos.update(point);
+}
+
 bool UCSwipeAreaPrivate::movingInRightDirection() const
 {
     if (direction == UCSwipeArea::Horizontal || direction == UCSwipeArea::Vertical) {
@@ -725,6 +805,40 @@ bool UCSwipeAreaPrivate::movedFarEnoughAlongGestureAxis() const
     }
 }
 
+/*
+    Whether the touch point is moving fast enough, and straight enough, along the gesture
+    direction for the gesture to be recognized before crossing the distance threshold.
+ */
+bool UCSwipeAreaPrivate::movingFastEnoughAlongGestureAxis() const
+{
+    if (earlyRecognitionSpeed <= 0. || velocityEstimator.sampleCount() < 3) {
+        // early recognition is disabled or there isn't enough data for a reliable estimate
+        return false;
+    }
+
+    QPointF totalMovement(dampedScenePos.x() - startScenePos.x(),
+                          dampedScenePos.y() - startScenePos.y());
+    qreal distanceAlongAxis = projectOntoDirectionVector(totalMovement);
+
+    // velocityEstimator works in pixels per millisecond
+    const QPointF velocity = velocityEstimator.velocity() * 1000.;
+    qreal speedAlongAxis = projectOntoDirectionVector(velocity);
+    const qreal speed = qSqrt(velocity.x()*velocity.x() + velocity.y()*velocity.y());
+
+    if ((direction == UCSwipeArea::Horizontal || direction == UCSwipeArea::Vertical)
+            && speedAlongAxis < 0.) {
+        speedAlongAxis = -speedAlongAxis;
+        distanceAlongAxis = -distanceAlongAxis;
+    }
+
+    SA_TRACE(" movingFastEnoughAlongGestureAxis: speedAlongAxis=" << speedAlongAxis
+        << ", speed=" << speed << ", earlyRecognitionSpeed=" << earlyRecognitionSpeed);
+
+    return distanceAlongAxis > 0.
+        && speedAlongAxis >= earlyRecognitionSpeed
+        && speedAlongAxis >= earlyRecognitionConfidence * speed;
+}
+
 bool UCSwipeAreaPrivate::isPastMaxDistance() const
 {
     QPointF totalMovement(dampedScenePos.x() - startScenePos.x(),
@@ -839,6 +953,29 @@ void UCSwipeAreaPrivate::updatePosition(const QPointF &point)
     }
 }
 
+void UCSwipeAreaPrivate::resetVelocity(const QPointF &point)
+{
+    velocityEstimator.reset();
+    addVelocitySample(point, timeSource->msecsSinceReference());
+    updateVelocity();
+}
+
+void UCSwipeAreaPrivate::addVelocitySample(const QPointF &point, qint64 time)
+{
+    velocityEstimator.addSample(point, time);
+}
+
+void UCSwipeAreaPrivate::updateVelocity()
+{
+    // velocityEstimator works in pixels per millisecond
+    qreal velocity = projectOntoDirectionVector(velocityEstimator.velocity() * 1000.);
+    if (velocity != sceneVelocity) {
+        sceneVelocity = velocity;
+        Q_Q(UCSwipeArea);
+        Q_EMIT q->velocityChanged(sceneVelocity);
+    }
+}
+
 bool UCSwipeAreaPrivate::isWithinTouchCompositionWindow()
 {
     return
@@ -870,8 +1007,12 @@ void UCSwipeArea::itemChange(ItemChange change, const ItemChangeData &value)
     }
 }
 
-void UCSwipeAreaPrivate::setPixelsPerMm(qreal pixelsPerMm)
+void UCSwipeAreaPrivate::setPixelsPerMm(qreal value)
 {
+    pixelsPerMm = value;
+    if (earlyRecognition) {
+        earlyRecognitionSpeed = 50. * pixelsPerMm;
+    }
     dampedScenePos.setMaxDelta(1. * pixelsPerMm);
     setDistanceThreshold(4. * pixelsPerMm);
     maxDistance = 10. * pixelsPerMm;
@@ -1021,12 +1162,17 @@ UCSwipeAreaPrivate::UCSwipeAreaPrivate()
     , distanceThresholdSquared(0.)
     , maxDistance(0.)
     , sceneDistance(0.)
+    , sceneVelocity(0.)
+    , earlyRecognitionSpeed(0.)
+    , earlyRecognitionConfidence(0.9)
+    , pixelsPerMm(0.)
     , touchId(-1)
     , maxTime(400)
     , compositionTime(60)
     , status(WaitingForTouch)
     , direction(UCSwipeArea::Rightwards)
     , immediateRecognition(false)
+    , earlyRecognition(false)
     , grabGesture(true)
 {
 }
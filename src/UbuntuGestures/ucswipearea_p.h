@@ -35,6 +35,7 @@ class UBUNTUGESTURES_EXPORT UCSwipeArea : public QQuickItem
 
     Q_PROPERTY(Direction direction READ direction WRITE setDirection NOTIFY directionChanged)
     Q_PROPERTY(qreal distance READ distance NOTIFY distanceChanged)
+    Q_PROPERTY(qreal velocity READ velocity NOTIFY velocityChanged)
     Q_PROPERTY(QPointF touchPosition READ touchPosition NOTIFY touchPositionChanged)
     Q_PROPERTY(bool dragging READ dragging NOTIFY draggingChanged)
     Q_PROPERTY(bool pressed READ pressed NOTIFY pressedChanged)
@@ -43,6 +44,7 @@ class UBUNTUGESTURES_EXPORT UCSwipeArea : public QQuickItem
             WRITE setImmediateRecognition
             NOTIFY immediateRecognitionChanged)
     Q_PROPERTY(bool grabGesture READ grabGesture WRITE setGrabGesture NOTIFY grabGestureChanged FINAL)
+    Q_PROPERTY(bool earlyRecognition READ earlyRecognition WRITE setEarlyRecognition NOTIFY earlyRecognitionChanged FINAL)
 
     Q_ENUMS(Direction)
 public:
@@ -62,6 +64,8 @@ public:
 
     qreal distance() const;
 
+    qreal velocity() const;
+
     QPointF touchPosition() const;
 
     bool dragging() const;
@@ -74,14 +78,19 @@ public:
     bool grabGesture() const;
     void setGrabGesture(bool enabled);
 
+    bool earlyRecognition() const;
+    void setEarlyRecognition(bool enabled);
+
 Q_SIGNALS:
     void directionChanged(Direction direction);
     void draggingChanged(bool dragging);
     void pressedChanged(bool pressed);
     void distanceChanged(qreal distance);
+    void velocityChanged(qreal velocity);
     void touchPositionChanged(const QPointF &position);
     void immediateRecognitionChanged(bool immediateRecognition);
     void grabGestureChanged(bool grabGesture);
+    void earlyRecognitionChanged(bool earlyRecognition);
 
 protected:
     bool event(QEvent *e) override;
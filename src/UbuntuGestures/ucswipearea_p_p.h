@@ -22,6 +22,7 @@
 #include <QtQuick/private/qquickitem_p.h>
 
 #include <UbuntuGestures/private/damper_p.h>
+#include <UbuntuGestures/private/velocityestimator_p.h>
 
 UG_NAMESPACE_BEGIN
 
@@ -67,6 +68,13 @@ public:
 
     void setCompositionTime(int value);
 
+    // Speed (in pixels per second) and direction confidence needed along the gesture
+    // direction for a gesture to be recognized before crossing the distance threshold.
+    // A speed of zero disables early recognition. The earlyRecognition property sets
+    // the speed from the pixel density of the screen.
+    void setEarlyRecognitionSpeed(qreal value);
+    void setEarlyRecognitionConfidence(qreal value);
+
     // Replaces the existing Timer with the given one.
     //
     // Useful for providing a fake timer when testing.
@@ -99,12 +107,17 @@ public:
     void touchEvent_absent(QTouchEvent *event);
     void touchEvent_undecided(QTouchEvent *event);
     void touchEvent_recognized(QTouchEvent *event);
+    void updateDampedScenePos(const QPointF &point);
     bool movingInRightDirection() const;
     bool movedFarEnoughAlongGestureAxis() const;
+    bool movingFastEnoughAlongGestureAxis() const;
     bool isPastMaxDistance() const;
     const QTouchEvent::TouchPoint *fetchTargetTouchPoint(QTouchEvent *event);
     void setStatus(Status newStatus);
     void updatePosition(const QPointF &point);
+    void resetVelocity(const QPointF &point);
+    void addVelocitySample(const QPointF &point, qint64 time);
+    void updateVelocity();
     void setPublicScenePos(const QPointF &point);
     bool isWithinTouchCompositionWindow();
     void updateSceneDirectionVector();
@@ -118,7 +131,7 @@ public:
     bool recognitionIsDisabled() const;
     bool sanityCheckRecognitionProperties();
     void setDistanceThreshold(qreal value);
-    void setPixelsPerMm(qreal pixelsPerMm);
+    void setPixelsPerMm(qreal value);
     QString objectName() const { return q_func()->objectName(); }
 
     // manage status change listeners
@@ -137,6 +150,8 @@ public:
     QPointF sceneDirectionVector;
     UG_PREPEND_NAMESPACE(SharedTimeSource) timeSource;
     ActiveTouchesInfo activeTouches;
+    // Estimates the velocity of the touch point performing the gesture
+    VelocityEstimator velocityEstimator;
 
     // status change listeners
     QList<UCSwipeAreaStatusListener*> statusChangeListeners;
@@ -150,6 +165,18 @@ public:
     // Maximum distance the gesture can go without crossing the axis-aligned distance threshold
     qreal maxDistance;
     qreal sceneDistance;
+    // Velocity along the gesture direction, in pixels per second, exposed in the public API.
+    qreal sceneVelocity;
+
+    // Minimum speed (in pixels per second) along the gesture direction for the gesture to be
+    // recognized before it goes beyond the distance threshold. Early recognition is opt-in,
+    // it's disabled by the default value of 0 so that gestures keep being recognized by distance.
+    qreal earlyRecognitionSpeed;
+    qreal pixelsPerMm;
+    // Minimum ratio between the speed along the gesture direction and the overall speed for
+    // early recognition. It's the cosine of the largest angle the velocity can make with
+    // the gesture direction.
+    qreal earlyRecognitionConfidence;
 
     int touchId;
     // Maximum time (in milliseconds) the gesture can take to go beyond the distance threshold
@@ -164,6 +191,7 @@ public:
     UCSwipeArea::Direction direction;
 
     bool immediateRecognition;
+    bool earlyRecognition;
     bool grabGesture;
 };
 
@@ -40,4 +40,14 @@ QTouchEvent *UnownedTouchEvent::touchEvent()
     return m_touchEvent.data();
 }
 
+TouchHistory UnownedTouchEvent::history(int touchId) const
+{
+    return m_history.value(touchId);
+}
+
+void UnownedTouchEvent::setHistory(const QHash<int, TouchHistory> &history)
+{
+    m_history = history;
+}
+
 UG_NAMESPACE_END
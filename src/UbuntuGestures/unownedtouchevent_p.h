@@ -17,12 +17,25 @@
 #ifndef UNOWNEDTOUCHEVENT_P_H
 #define UNOWNEDTOUCHEVENT_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QVector>
 #include <QtGui/QTouchEvent>
 
 #include <UbuntuGestures/ubuntugesturesglobal.h>
 
 UG_NAMESPACE_BEGIN
+
+/*
+ A position a touch point went through, in the same coordinate system as
+ QTouchEvent::TouchPoint::scenePos() of the UnownedTouchEvent carrying it.
+ */
+struct TouchHistoryPoint {
+    QPointF scenePos;
+    ulong timestamp;
+};
+typedef QVector<TouchHistoryPoint> TouchHistory;
+
 /*
  A touch event with touch points that do not belong the item receiving it.
 
@@ -39,9 +52,16 @@ public:
     //       is very convenient.
     QTouchEvent *touchEvent();
 
+    // Every position the touch point with the given id went through since the previous
+    // UnownedTouchEvent, oldest first, the last one being its current position.
+    // Only filled when TouchRegistry coalesces touch updates, empty otherwise.
+    TouchHistory history(int touchId) const;
+    void setHistory(const QHash<int, TouchHistory> &history);
+
 private:
     static Type m_unownedTouchEventType;
     QScopedPointer<QTouchEvent> m_touchEvent;
+    QHash<int, TouchHistory> m_history;
 };
 
 UG_NAMESPACE_END
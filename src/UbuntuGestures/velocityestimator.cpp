@@ -0,0 +1,99 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "velocityestimator_p.h"
+
+UG_NAMESPACE_BEGIN
+
+VelocityEstimator::VelocityEstimator()
+    : m_next(0)
+    , m_count(0)
+{
+}
+
+void VelocityEstimator::reset()
+{
+    m_next = 0;
+    m_count = 0;
+}
+
+void VelocityEstimator::addSample(const QPointF &position, qint64 time)
+{
+    m_samples[m_next].position = position;
+    m_samples[m_next].time = time;
+    m_next = (m_next + 1) % MaxSamples;
+    if (m_count < MaxSamples) {
+        ++m_count;
+    }
+}
+
+int VelocityEstimator::sampleCount() const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    const Sample &newest = m_samples[(m_next + MaxSamples - 1) % MaxSamples];
+    int count = 1;
+    while (count < m_count) {
+        const Sample &sample = m_samples[(m_next + MaxSamples - 1 - count) % MaxSamples];
+        if (newest.time - sample.time > MaxSampleAge) {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+QPointF VelocityEstimator::velocity() const
+{
+    const int count = sampleCount();
+    if (count < 2) {
+        return QPointF();
+    }
+
+    // Times and positions are made relative to the newest sample to keep the sums small.
+    const Sample &newest = m_samples[(m_next + MaxSamples - 1) % MaxSamples];
+    qreal sumT = 0.;
+    qreal sumTT = 0.;
+    qreal sumX = 0.;
+    qreal sumY = 0.;
+    qreal sumTX = 0.;
+    qreal sumTY = 0.;
+    for (int i = 0; i < count; ++i) {
+        const Sample &sample = m_samples[(m_next + MaxSamples - 1 - i) % MaxSamples];
+        const qreal t = sample.time - newest.time;
+        const qreal x = sample.position.x() - newest.position.x();
+        const qreal y = sample.position.y() - newest.position.y();
+        sumT += t;
+        sumTT += t * t;
+        sumX += x;
+        sumY += y;
+        sumTX += t * x;
+        sumTY += t * y;
+    }
+
+    const qreal denominator = count * sumTT - sumT * sumT;
+    if (qFuzzyIsNull(denominator)) {
+        // all samples happened at the same time
+        return QPointF();
+    }
+
+    return QPointF((count * sumTX - sumT * sumX) / denominator,
+                   (count * sumTY - sumT * sumY) / denominator);
+}
+
+UG_NAMESPACE_END
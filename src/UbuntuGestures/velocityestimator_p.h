@@ -0,0 +1,71 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VELOCITYESTIMATOR_P_H
+#define VELOCITYESTIMATOR_P_H
+
+#include <QtCore/QPointF>
+
+#include <UbuntuGestures/ubuntugesturesglobal.h>
+
+UG_NAMESPACE_BEGIN
+
+/*
+  Estimates the velocity of a moving point from its most recent positions.
+
+  The positions are kept in a ring buffer and a line is fitted through them, for each axis,
+  using the method of least squares. The velocity is the slope of that line.
+ */
+class UBUNTUGESTURES_EXPORT VelocityEstimator
+{
+public:
+    VelocityEstimator();
+
+    // Maximum number of positions kept
+    static const int MaxSamples = 16;
+
+    // Positions older than that, in milliseconds, relative to the most recent one are ignored
+    static const int MaxSampleAge = 100;
+
+    // Forgets all positions
+    void reset();
+
+    // Adds the position the point was at the given time, in milliseconds.
+    // Positions have to be added in chronological order.
+    void addSample(const QPointF &position, qint64 time);
+
+    // The number of positions taken into account by velocity()
+    int sampleCount() const;
+
+    // Velocity, in pixels per millisecond, at the time of the most recent position.
+    // It's null if there aren't at least two positions to take into account.
+    QPointF velocity() const;
+
+private:
+    struct Sample {
+        QPointF position;
+        qint64 time;
+    };
+
+    Sample m_samples[MaxSamples];
+    // Index where the next sample will be written
+    int m_next;
+    int m_count;
+};
+
+UG_NAMESPACE_END
+
+#endif // VELOCITYESTIMATOR_P_H
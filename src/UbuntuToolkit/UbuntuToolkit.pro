@@ -95,6 +95,9 @@ HEADERS += \
     $$PWD/ucfontutils_p.h \
     $$PWD/uchaptics_p.h \
     $$PWD/ucheader_p.h \
+    $$PWD/uciconatlas_p.h \
+    $$PWD/ucimagecache_p.h \
+    $$PWD/ucimagediskcache_p.h \
     $$PWD/ucimportversionchecker_p.h \
     $$PWD/ucinversemouse_p.h \
     $$PWD/uclabel_p.h \
@@ -121,6 +124,7 @@ HEADERS += \
     $$PWD/ucserviceproperties_p_p.h \
     $$PWD/ucslotslayout_p.h \
     $$PWD/ucslotslayout_p_p.h \
+    $$PWD/ucsoftwareshapenode_p.h \
     $$PWD/ucstatesaver_p.h \
     $$PWD/ucstatesaver_p_p.h \
     $$PWD/ucstyleditembase_p.h \
@@ -198,6 +202,9 @@ SOURCES += \
     $$PWD/ucfontutils.cpp \
     $$PWD/uchaptics.cpp \
     $$PWD/ucheader.cpp \
+    $$PWD/uciconatlas.cpp \
+    $$PWD/ucimagecache.cpp \
+    $$PWD/ucimagediskcache.cpp \
     $$PWD/ucimportversionchecker_p.cpp \
     $$PWD/uclabel.cpp \
     $$PWD/uclistitem.cpp \
@@ -215,6 +222,7 @@ SOURCES += \
     $$PWD/ucscalingimageprovider.cpp \
     $$PWD/ucserviceproperties.cpp \
     $$PWD/ucslotslayout.cpp \
+    $$PWD/ucsoftwareshapenode.cpp \
     $$PWD/ucstatesaver.cpp \
     $$PWD/ucstyleditembase.cpp \
     $$PWD/ucstylehints.cpp \
@@ -20,8 +20,10 @@
 
 #include <QtGui/QOpenGLContext>
 #include <QtGui/QOpenGLFunctions>
+#include <QtGui/QPainter>
 
 #include "privates/textures_p.h"
+#include "ucsoftwareshapenode_p.h"
 
 UT_NAMESPACE_BEGIN
 
@@ -466,10 +468,54 @@ QSGNode* UCFrame::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data)
         return NULL;
     }
 
-    UCFrameNode* node = oldNode ? static_cast<UCFrameNode*>(oldNode) : new UCFrameNode();
-    node->updateGeometry(itemSize, m_thickness, m_radius, m_color);
+    QSGNode* node = oldNode;
+    if (!node) {
+        if (UCSoftwareShapeNode::isSoftwareRendering(window())) {
+            node = new UCSoftwareShapeNode(window());
+        } else {
+            node = new UCFrameNode();
+        }
+    }
+    if (node->type() == QSGNode::RenderNodeType) {
+        updateSoftwareNode(static_cast<UCSoftwareShapeNode*>(node), itemSize);
+    } else {
+        static_cast<UCFrameNode*>(node)->updateGeometry(itemSize, m_thickness, m_radius, m_color);
+    }
 
     return node;
 }
 
+// Paints the frame with the software adaptation, the inner radius is scaled down with the
+// thickness like in UCFrameNode::updateGeometry().
+void UCFrame::updateSoftwareNode(UCSoftwareShapeNode* node, const QSizeF& itemSize)
+{
+    QImage* image = node->beginPaint(itemSize);
+    const qreal dpr = window()->effectiveDevicePixelRatio();
+    const float maxSize = qMin(itemSize.width(), itemSize.height()) * 0.5f;
+    const float thickness = qMin(m_thickness, maxSize);
+    const float radiusOut = qBound(0.0f, m_radius, maxSize);
+    const float radiusIn = radiusOut * ((maxSize - thickness) / maxSize);
+
+    QPainter painter(image);
+    painter.fillRect(image->rect(), QColor::fromRgba(m_color));
+    UCSoftwareShapeNode::maskCorners(&painter, image->rect(), qRound(radiusOut * dpr));
+
+    // Punch the inner rounded rectangle out.
+    const int thicknessPixels = qMax(1, qRound(thickness * dpr));
+    const QRect innerRect = image->rect().adjusted(
+        thicknessPixels, thicknessPixels, -thicknessPixels, -thicknessPixels);
+    if (innerRect.isValid()) {
+        QImage hole(innerRect.size(), QImage::Format_ARGB32_Premultiplied);
+        hole.fill(Qt::white);
+        QPainter holePainter(&hole);
+        UCSoftwareShapeNode::maskCorners(&holePainter, hole.rect(), qRound(radiusIn * dpr));
+        holePainter.end();
+        painter.setCompositionMode(QPainter::CompositionMode_DestinationOut);
+        painter.drawImage(innerRect.topLeft(), hole);
+    }
+    painter.end();
+
+    node->endPaint();
+}
+
 UT_NAMESPACE_END
@@ -27,6 +27,8 @@
 
 UT_NAMESPACE_BEGIN
 
+class UCSoftwareShapeNode;
+
 class UCFrameMaterial : public QSGMaterial
 {
 public:
@@ -92,6 +94,7 @@ Q_SIGNALS:
 
 private:
     QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void updateSoftwareNode(UCSoftwareShapeNode* node, const QSizeF& itemSize);
 
     QRgb m_color;
     float m_thickness;
@@ -16,18 +16,22 @@
 
 uniform highp mat4 matrix;  // mediump was interpreted as lowp on PowerVR Rogue G6200 (arale).
 uniform bool textured;
+uniform mediump float distanceAAScale;
 
 attribute highp vec4 positionAttrib;  // highp because of matrix precision qualifier.
 attribute mediump vec2 shapeCoordAttrib;
 attribute mediump vec4 sourceCoordAttrib;
 attribute lowp float yCoordAttrib;
 attribute lowp vec4 backgroundColorAttrib;
+attribute lowp vec2 parametersAttrib;  // Source opacity and anti-aliasing distance factor.
 
 // FIXME(loicm) Optimize by reducing/packing varyings.
 varying mediump vec2 shapeCoord;
 varying mediump vec4 sourceCoord;
 varying lowp float yCoord;
 varying lowp vec4 backgroundColor;
+varying lowp float sourceOpacity;
+varying lowp float distanceAA;
 
 void main()
 {
@@ -37,6 +41,8 @@ void main()
     }
     yCoord = yCoordAttrib;
     backgroundColor = backgroundColorAttrib;
+    sourceOpacity = parametersAttrib.x;
+    distanceAA = parametersAttrib.y * distanceAAScale;
 
     gl_Position = matrix * positionAttrib;
 }
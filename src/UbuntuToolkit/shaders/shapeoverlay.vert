@@ -16,6 +16,7 @@
 
 uniform highp mat4 matrix;  // mediump was interpreted as lowp on PowerVR Rogue G6200 (arale).
 uniform bool textured;
+uniform mediump float distanceAAScale;
 
 attribute highp vec4 positionAttrib;  // highp because of matrix precision qualifier.
 attribute mediump vec2 shapeCoordAttrib;
@@ -24,6 +25,7 @@ attribute lowp float yCoordAttrib;
 attribute lowp vec4 backgroundColorAttrib;
 attribute mediump vec2 overlayCoordAttrib;
 attribute lowp vec4 overlayColorAttrib;
+attribute lowp vec2 parametersAttrib;  // Source opacity and anti-aliasing distance factor.
 
 // FIXME(loicm) Optimize by reducing/packing varyings.
 varying mediump vec2 shapeCoord;
@@ -32,6 +34,8 @@ varying lowp float yCoord;
 varying lowp vec4 backgroundColor;
 varying mediump vec2 overlayCoord;
 varying lowp vec4 overlayColor;
+varying lowp float sourceOpacity;
+varying lowp float distanceAA;
 
 void main()
 {
@@ -43,6 +47,8 @@ void main()
     backgroundColor = backgroundColorAttrib;
     overlayCoord = overlayCoordAttrib;
     overlayColor = overlayColorAttrib;
+    sourceOpacity = parametersAttrib.x;
+    distanceAA = parametersAttrib.y * distanceAAScale;
 
     gl_Position = matrix * positionAttrib;
 }
@@ -24,8 +24,6 @@ uniform sampler2D shapeTexture;
 uniform sampler2D sourceTexture;
 uniform lowp vec2 opacityFactors;
 uniform lowp float dfdtFactor;
-uniform lowp float sourceOpacity;
-uniform lowp float distanceAA;
 uniform bool textured;
 uniform mediump int aspect;
 
@@ -35,6 +33,7 @@ varying lowp float yCoord;
 varying lowp vec4 backgroundColor;
 varying mediump vec2 overlayCoord;
 varying lowp vec4 overlayColor;
+varying lowp float sourceOpacity;
 
 const mediump int FLAT        = 0x08;  // 1 << 3
 const mediump int INSET       = 0x10;  // 1 << 4
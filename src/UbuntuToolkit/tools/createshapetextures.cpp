@@ -16,17 +16,23 @@
  * Author: Loïc Molinari <loic.molinari@canonical.com>
  */
 
-// This program creates the texture (as a C header) used by the UbuntuShape for its shape, shadows
-// and bevel. It uses distance fields to create efficient anti-aliased and resolution independent
-// contours. The EDTAA3 algorithm and implementation comes from Stefan Gustavson, for more
-// information see http://webstaff.itn.liu.se/~stegu/aadist/readme.pdf.
+// This program creates the textures used by the UbuntuShape for its shape, shadows and bevel. It
+// uses distance fields to create efficient anti-aliased and resolution independent contours. The
+// EDTAA3 algorithm and implementation comes from Stefan Gustavson, for more information see
+// http://webstaff.itn.liu.se/~stegu/aadist/readme.pdf.
 
-// In order to generate a new file, the following commands must be used:
+// The distance field textures are written as C arrays. The mipmap textures, only used when
+// distance fields aren't supported, are written one after the other to a raw file loaded from
+// the library's resources.
+
+// In order to generate new files, the following commands must be used:
 // $ cd tools
 // $ qmake && make
-// $ ./createshapetextures shape.svg ../plugin/ucubuntushapetexture.h
+// $ ./createshapetextures shape.svg ../ucubuntushapetextures_p.h ../ucubuntushapetextures.cpp \
+//       ../shapetextures/shape_mipmap.raw
 
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 #include <QtGui/QImage>
 #include <QtGui/QPainter>
@@ -47,6 +53,7 @@ const int widthMipmap = 256;
 const int heightMipmap = 256;
 const int sizeMipmap = widthMipmap * heightMipmap;
 const int mipmapCount = 9;  // Minimum size is 1.
+const char* const mipmapResource = ":/uc/shapetextures/shape_mipmap.raw";
 const int biggestSize = size > sizeMipmap ? size : sizeMipmap;
 
 // Shape buffers.
@@ -358,14 +365,28 @@ static void dumpTexture(QTextStream& cppOut, const uint* data, int size)
     }
 }
 
+static void dumpTextureRaw(QFile& rawOut, const uint* data, int size)
+{
+    QByteArray bytes(size * 4, Qt::Uninitialized);
+    for (int i = 0; i < size; i++) {
+        bytes[i * 4] = data[i] & 0xff;
+        bytes[i * 4 + 1] = (data[i] >> 8) & 0xff;
+        bytes[i * 4 + 2] = (data[i] >> 16) & 0xff;
+        bytes[i * 4 + 3] = (data[i] >> 24) & 0xff;
+    }
+    rawOut.write(bytes);
+}
+
 int main(int argc, char* argv[])
 {
-    if (argc != 3) {
-        qWarning("Usage: createshapetextures input_svg output_cpp");
+    if (argc != 5) {
+        qWarning("Usage: createshapetextures input_svg output_header output_cpp output_raw");
         return 1;
     }
     const char* svgFilename = argv[1];
-    const char* cppFilename = argv[2];
+    const char* headerFilename = argv[2];
+    const char* cppFilename = argv[3];
+    const char* rawFilename = argv[4];
 
     // Open files.
     QSvgRenderer svg;
@@ -373,26 +394,44 @@ int main(int argc, char* argv[])
         qWarning("Can't open input SVG file \'%s\'", svgFilename);
         return 1;
     }
+    QFile headerFile(headerFilename);
+    if (!headerFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning("Can't create output header file \'%s\'", headerFilename);
+        return 1;
+    }
     QFile cppFile(cppFilename);
     if (!cppFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
         qWarning("Can't create output C++ file \'%s\'", cppFilename);
         return 1;
     }
+    QFile rawFile(rawFilename);
+    if (!rawFile.open(QIODevice::WriteOnly)) {
+        qWarning("Can't create output raw file \'%s\'", rawFilename);
+        return 1;
+    }
 
+    QTextStream headerOut(&headerFile);
+    headerOut << "// Copyright 2015 Canonical Ltd.\n"
+              << "// Automatically generated by the createshapetextures tool.\n"
+              << "#ifndef UCUBUNTUSHAPETEXTURES_H\n"
+              << "#define UCUBUNTUSHAPETEXTURES_H\n\n";
     QTextStream cppOut(&cppFile);
     cppOut << "// Copyright 2015 Canonical Ltd.\n"
-           << "// Automatically generated by the createshapetextures tool.\n\n";
+           << "// Automatically generated by the createshapetextures tool.\n\n"
+           << "#include \"" << QFileInfo(headerFilename).fileName() << "\"\n\n";
 
     // Create the distance field textures and write them to the C++ file.
     QImage shape(reinterpret_cast<uchar*>(renderBuffer), width, height,
                  width * 4, QImage::Format_ARGB32_Premultiplied);
     QPainter painter(&shape);
-    cppOut << "const int shapeTextureCount = " << textureCount << ";\n"
-           << "const int shapeTextureWidth = " << width << ";\n"
-           << "const int shapeTextureHeight = " << height << ";\n"
-           << "const float shapeTextureOffset = " << shapeOffset << ";\n"
-           << "const int shapeTextureDistanceAA = " << distanceScale << ";\n"
-           << "static const unsigned char shapeTextureData[" << textureCount
+    headerOut << "const int shapeTextureCount = " << textureCount << ";\n"
+              << "const int shapeTextureWidth = " << width << ";\n"
+              << "const int shapeTextureHeight = " << height << ";\n"
+              << "const float shapeTextureOffset = " << shapeOffset << ";\n"
+              << "const int shapeTextureDistanceAA = " << distanceScale << ";\n\n"
+              << "extern const unsigned char shapeTextureData[" << textureCount
+              <<   "][" << width * height * 4 + 1 << "];\n\n";
+    cppOut << "const unsigned char shapeTextureData[" << textureCount
            <<   "][" << width * height * 4 + 1 << "] = {\n";
     createTexture1(&svg, &painter, textureData, width, height, true);
     dumpTexture(cppOut, textureData, width * height);
@@ -402,21 +441,26 @@ int main(int argc, char* argv[])
     cppOut << "};\n\n";
     painter.end();
 
-    // Create the mipmap textures and write them to the C++ file.
-    cppOut << "const int shapeTextureMipmapWidth = " << widthMipmap << ";\n"
-           << "const int shapeTextureMipmapHeight = " << heightMipmap << ";\n"
-           << "const int shapeTextureMipmapCount = " << mipmapCount << ";\n"
-           << "static const int shapeTextureMipmapOffset[" << mipmapCount << "] = {\n"
+    // Create the mipmap textures and write them to the raw file, with their offsets in the C++
+    // file.
+    headerOut << "const int shapeTextureMipmapWidth = " << widthMipmap << ";\n"
+              << "const int shapeTextureMipmapHeight = " << heightMipmap << ";\n"
+              << "const int shapeTextureMipmapCount = " << mipmapCount << ";\n\n"
+              << "extern const int shapeTextureMipmapOffset[" << mipmapCount << "];\n\n";
+    cppOut << "const int shapeTextureMipmapOffset[" << mipmapCount << "] = {\n"
            << "    0";
-    int size = 0, i = 0;
+    int size = 0;
     for (int i = 0; i < mipmapCount-1; i++) {
         size += (widthMipmap >> i) * (heightMipmap >> i) * 4;
         cppOut << ", " << size;
     }
     size += (widthMipmap >> (mipmapCount-1)) * (heightMipmap >> (mipmapCount-1)) * 4;
     cppOut << "\n};\n";
-    cppOut << "static const unsigned char shapeTextureMipmapData[" << textureCount
-           <<   "][" << size + 1 << "] = {\n";
+    headerOut << "// The mipmap textures, rarely used, are stored one after the other in a compressed resource\n"
+              << "// instead of the library.\n"
+              << "const int shapeTextureMipmapSize = " << size << ";\n"
+              << "const char* const shapeTextureMipmapResource = \"" << mipmapResource << "\";\n\n"
+              << "#endif // UCUBUNTUSHAPETEXTURES_H\n";
     for (int i = 0; i < mipmapCount; i++) {
         const int width = widthMipmap >> i;
         const int height = heightMipmap >> i;
@@ -424,11 +468,9 @@ int main(int argc, char* argv[])
                            width * 4, QImage::Format_ARGB32_Premultiplied);
         painter.begin(&shapeMipmap);
         createTexture1(&svg, &painter, textureDataMipmap, width, height, false);
-        cppOut << "    // Mipmap level " << i << ".\n";
-        dumpTexture(cppOut, textureDataMipmap, width * height);
+        dumpTextureRaw(rawFile, textureDataMipmap, width * height);
         painter.end();
     }
-    cppOut << "    ,\n";
     for (int i = 0; i < mipmapCount; i++) {
         const int width = widthMipmap >> i;
         const int height = heightMipmap >> i;
@@ -436,11 +478,9 @@ int main(int argc, char* argv[])
                            width * 4, QImage::Format_ARGB32_Premultiplied);
         painter.begin(&shapeMipmap);
         createTexture2(&svg, &painter, textureDataMipmap, width, height, false);
-        cppOut << "    // Mipmap level " << i << ".\n";
-        dumpTexture(cppOut, textureDataMipmap, width * height);
+        dumpTextureRaw(rawFile, textureDataMipmap, width * height);
         painter.end();
     }
-    cppOut << "};\n";
 
     return 0;
 }
@@ -73,6 +73,7 @@
 #include "ucfontutils_p.h"
 #include "uchaptics_p.h"
 #include "ucheader_p.h"
+#include "ucimagecache_p.h"
 #include "ucinversemouse_p.h"
 #include "uclabel_p.h"
 #include "uclistitem_p.h"
@@ -399,6 +400,7 @@ void UbuntuToolkitModule::defineModule()
     qmlRegisterType<UCMainViewBase>(uri, 1, 3, "MainViewBase");
     qmlRegisterType<ActionList>(uri, 1, 3, "ActionList");
     qmlRegisterType<ExclusiveGroup>(uri, 1, 3, "ExclusiveGroup");
+    qmlRegisterSingletonType<UCImageCache>(uri, 1, 3, "ImageCache", UCImageCache::singleton);
 }
 
 void UbuntuToolkitModule::undefineModule()
@@ -68,6 +68,11 @@ public:
 
     // from UCStyledItemBase
     bool loadStyleItem(bool animated = true) override;
+    bool canDelayStyleLoading() const override
+    {
+        // the style is post-processed right after loading
+        return false;
+    }
     // from QQuickItemChangeListener
     void itemChildAdded(QQuickItem *item, QQuickItem *child) override;
     void itemChildRemoved(QQuickItem *item, QQuickItem *child) override;
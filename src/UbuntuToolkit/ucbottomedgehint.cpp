@@ -138,6 +138,7 @@ void UCBottomEdgeHint::init()
 
     // direction
     d->swipeArea->setDirection(UCSwipeArea::Upwards);
+    d->swipeArea->setEarlyRecognition(true);
 
     // grid unit sync
     connect(UCUnits::instance(), &UCUnits::gridUnitChanged, this, &UCBottomEdgeHint::onGridUnitChanged);
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uciconatlas_p.h"
+
+#include <QtCore/QMutex>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QPainter>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qsgtexture_p.h>
+
+UT_NAMESPACE_BEGIN
+
+static QHash<QOpenGLContext*, UCIconAtlas*> iconAtlasHash;
+static QMutex iconAtlasHashMutex;
+
+UCIconAtlas::UCIconAtlas(QOpenGLContext *context)
+    : m_context(context)
+    , m_textureId(0)
+    , m_refCount(0)
+    , m_shelvesHeight(0)
+{
+    glGenTextures(1, &m_textureId);
+    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, iconAtlasSize, iconAtlasSize, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, Q_NULLPTR);
+    m_contextDestroyedConnection = QObject::connect(
+        context, &QOpenGLContext::aboutToBeDestroyed, [this] { contextDestroyed(); });
+}
+
+// Textures can be deleted while another context is current, e.g. when the
+// window releases its resources. The atlas texture is then deleted along with
+// its context, like the Frame textures.
+UCIconAtlas::~UCIconAtlas()
+{
+    if (m_context) {
+        QObject::disconnect(m_contextDestroyedConnection);
+        if (QOpenGLContext::currentContext() == m_context) {
+            glDeleteTextures(1, &m_textureId);
+        } else {
+            QOpenGLContext *context = m_context;
+            const quint32 textureId = m_textureId;
+            QObject::connect(context, &QOpenGLContext::aboutToBeDestroyed, [context, textureId] {
+                if (QOpenGLContext::currentContext() == context) {
+                    glDeleteTextures(1, &textureId);
+                }
+            });
+        }
+    }
+    qDeleteAll(m_entries);
+}
+
+UCIconAtlas *UCIconAtlas::ref(QOpenGLContext *context)
+{
+    QMutexLocker lock(&iconAtlasHashMutex);
+    UCIconAtlas *&atlas = iconAtlasHash[context];
+    if (!atlas) {
+        atlas = new UCIconAtlas(context);
+    }
+    atlas->m_refCount++;
+    return atlas;
+}
+
+void UCIconAtlas::unref()
+{
+    QMutexLocker lock(&iconAtlasHashMutex);
+    Q_ASSERT(m_refCount > 0);
+    if (--m_refCount == 0) {
+        if (m_context) {
+            iconAtlasHash.remove(m_context);
+        }
+        delete this;
+    }
+}
+
+// Textures of the icons can outlive the context, the atlas is then detached
+// from it so that a context created at the same address gets a new one.
+void UCIconAtlas::contextDestroyed()
+{
+    QMutexLocker lock(&iconAtlasHashMutex);
+    if (QOpenGLContext::currentContext() == m_context) {
+        glDeleteTextures(1, &m_textureId);
+    }
+    QObject::disconnect(m_contextDestroyedConnection);
+    iconAtlasHash.remove(m_context);
+    m_context = Q_NULLPTR;
+    m_textureId = 0;
+}
+
+// Returns the entry of the image, placing it in the atlas if needed, or null
+// if there is no room left.
+UCIconAtlasEntry *UCIconAtlas::acquire(const QImage &image)
+{
+    UCIconAtlasEntry *entry = m_entries.value(image.cacheKey());
+    if (entry) {
+        if (entry->refCount++ == 0) {
+            m_unused.removeOne(entry);
+        }
+        return entry;
+    }
+
+    const QSize paddedSize = image.size() + QSize(2, 2);
+    int shelf = findShelf(paddedSize);
+    if (shelf < 0 && !m_unused.isEmpty()) {
+        evictUnused();
+        shelf = findShelf(paddedSize);
+    }
+    if (shelf < 0) {
+        return Q_NULLPTR;
+    }
+
+    Shelf &s = m_shelves[shelf];
+    entry = new UCIconAtlasEntry;
+    entry->key = image.cacheKey();
+    entry->rect = QRect(s.x + 1, s.y + 1, image.width(), image.height());
+    entry->shelf = shelf;
+    entry->refCount = 1;
+    s.x += paddedSize.width();
+    s.entryCount++;
+    m_entries.insert(entry->key, entry);
+
+    // premultiplied RGBA as the scene graph expects, with a transparent border
+    // so that linear filtering does not bleed neighbouring icons in
+    QImage padded(paddedSize, QImage::Format_RGBA8888_Premultiplied);
+    padded.fill(Qt::transparent);
+    QPainter painter(&padded);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(1, 1, image);
+    painter.end();
+    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, s.x - paddedSize.width(), s.y, paddedSize.width(), paddedSize.height(),
+                    GL_RGBA, GL_UNSIGNED_BYTE, padded.constBits());
+    return entry;
+}
+
+void UCIconAtlas::release(UCIconAtlasEntry *entry)
+{
+    Q_ASSERT(entry->refCount > 0);
+    if (--entry->refCount == 0) {
+        m_unused.append(entry);
+    }
+}
+
+// Returns the index of the shelf to place an icon of @size in, or -1.
+int UCIconAtlas::findShelf(const QSize &size)
+{
+    for (int i = 0; i < m_shelves.size(); i++) {
+        Shelf &shelf = m_shelves[i];
+        if (shelf.entryCount == 0) {
+            shelf.x = 0;
+        }
+        // do not waste shelves on much smaller icons
+        if (size.height() <= shelf.height && size.height() * 3 >= shelf.height * 2
+                && iconAtlasSize - shelf.x >= size.width()) {
+            return i;
+        }
+    }
+    if (iconAtlasSize - m_shelvesHeight >= size.height()) {
+        Shelf shelf = { m_shelvesHeight, size.height(), 0, 0 };
+        m_shelves.append(shelf);
+        m_shelvesHeight += size.height();
+        return m_shelves.size() - 1;
+    }
+    return -1;
+}
+
+void UCIconAtlas::evictUnused()
+{
+    Q_FOREACH(UCIconAtlasEntry *entry, m_unused) {
+        m_shelves[entry->shelf].entryCount--;
+        m_entries.remove(entry->key);
+        delete entry;
+    }
+    m_unused.clear();
+}
+
+UCIconAtlasTexture::UCIconAtlasTexture(UCIconAtlas *atlas, UCIconAtlasEntry *entry, const QImage &image)
+    : m_atlas(atlas)
+    , m_entry(entry)
+    , m_image(image)
+    , m_removedFromAtlas(Q_NULLPTR)
+{
+}
+
+// static
+UCIconAtlasTexture *UCIconAtlasTexture::create(const QImage &image)
+{
+    // other scene graph backends use their own textures
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context || image.isNull()
+            || image.width() > iconAtlasMaxIconSize || image.height() > iconAtlasMaxIconSize) {
+        return Q_NULLPTR;
+    }
+    UCIconAtlas *atlas = UCIconAtlas::ref(context);
+    UCIconAtlasEntry *entry = atlas->acquire(image);
+    if (!entry) {
+        atlas->unref();
+        return Q_NULLPTR;
+    }
+    return new UCIconAtlasTexture(atlas, entry, image);
+}
+
+UCIconAtlasTexture::~UCIconAtlasTexture()
+{
+    delete m_removedFromAtlas;
+    m_atlas->release(m_entry);
+    m_atlas->unref();
+}
+
+int UCIconAtlasTexture::textureId() const
+{
+    return m_atlas->textureId();
+}
+
+QSize UCIconAtlasTexture::textureSize() const
+{
+    return m_entry->rect.size();
+}
+
+bool UCIconAtlasTexture::hasAlphaChannel() const
+{
+    return m_image.hasAlphaChannel();
+}
+
+QRectF UCIconAtlasTexture::normalizedTextureSubRect() const
+{
+    const QRect &rect = m_entry->rect;
+    return QRectF(rect.x() / qreal(iconAtlasSize), rect.y() / qreal(iconAtlasSize),
+                  rect.width() / qreal(iconAtlasSize), rect.height() / qreal(iconAtlasSize));
+}
+
+// Used by the nodes needing a texture of its own, e.g. to repeat it.
+QSGTexture *UCIconAtlasTexture::removedFromAtlas() const
+{
+    if (!m_removedFromAtlas) {
+        QSGPlainTexture *texture = new QSGPlainTexture;
+        texture->setImage(m_image);
+        texture->setFiltering(filtering());
+        m_removedFromAtlas = texture;
+    }
+    return m_removedFromAtlas;
+}
+
+void UCIconAtlasTexture::bind()
+{
+    glBindTexture(GL_TEXTURE_2D, m_atlas->textureId());
+    updateBindOptions();
+}
+
+UCIconTextureFactory::UCIconTextureFactory(const QImage &image)
+    : m_image(image)
+{
+}
+
+QSGTexture *UCIconTextureFactory::createTexture(QQuickWindow *window) const
+{
+    // called on the render thread
+    QSGTexture *texture = UCIconAtlasTexture::create(m_image);
+    if (!texture) {
+        texture = window->createTextureFromImage(m_image, QQuickWindow::TextureCanUseAtlas);
+    }
+    return texture;
+}
+
+QSize UCIconTextureFactory::textureSize() const
+{
+    return m_image.size();
+}
+
+int UCIconTextureFactory::textureByteCount() const
+{
+    return m_image.bytesPerLine() * m_image.height();
+}
+
+QImage UCIconTextureFactory::image() const
+{
+    return m_image;
+}
+
+UT_NAMESPACE_END
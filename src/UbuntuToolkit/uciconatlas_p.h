@@ -0,0 +1,142 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UCICONATLAS_P_H
+#define UCICONATLAS_P_H
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+#include <QtQuick/QQuickImageProvider>
+#include <QtQuick/QSGTexture>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+QT_FORWARD_DECLARE_CLASS(QOpenGLContext)
+
+UT_NAMESPACE_BEGIN
+
+// Icons up to iconAtlasMaxIconSize pixels wide and high share a texture of
+// iconAtlasSize x iconAtlasSize pixels, one per OpenGL context.
+const int iconAtlasSize = 1024;
+const int iconAtlasMaxIconSize = 128;
+
+struct UCIconAtlasEntry {
+    qint64 key;
+    QRect rect; // without the 1 pixel transparent padding
+    int shelf;
+    int refCount;
+};
+
+/*
+ * Icons are laid out in shelves, rows as high as the first icon placed in
+ * them. Icons no longer shown are kept until the space is needed, so icons
+ * coming back are not uploaded again. Once the atlas is full they are all
+ * evicted, and the shelves they emptied are reused.
+ */
+class UBUNTUTOOLKIT_EXPORT UCIconAtlas
+{
+public:
+    static UCIconAtlas *ref(QOpenGLContext *context);
+    void unref();
+
+    UCIconAtlasEntry *acquire(const QImage &image);
+    void release(UCIconAtlasEntry *entry);
+
+    quint32 textureId() const
+    {
+        return m_textureId;
+    }
+
+private:
+    struct Shelf {
+        int y;
+        int height;
+        int x;
+        int entryCount;
+    };
+
+    explicit UCIconAtlas(QOpenGLContext *context);
+    ~UCIconAtlas();
+
+    int findShelf(const QSize &size);
+    void evictUnused();
+    void contextDestroyed();
+
+    QOpenGLContext *m_context;
+    QMetaObject::Connection m_contextDestroyedConnection;
+    quint32 m_textureId;
+    quint32 m_refCount;
+    int m_shelvesHeight;
+    QVector<Shelf> m_shelves;
+    QHash<qint64, UCIconAtlasEntry*> m_entries;
+    QList<UCIconAtlasEntry*> m_unused;
+};
+
+// An icon placed in the icon atlas of an OpenGL context, so that the nodes
+// showing icons can be batched.
+class UBUNTUTOOLKIT_EXPORT UCIconAtlasTexture : public QSGTexture
+{
+public:
+    ~UCIconAtlasTexture();
+
+    // Returns null if there is no current OpenGL context, the image is too
+    // large or the atlas is full.
+    static UCIconAtlasTexture *create(const QImage &image);
+
+    int textureId() const override;
+    QSize textureSize() const override;
+    bool hasAlphaChannel() const override;
+    bool hasMipmaps() const override
+    {
+        return false;
+    }
+    bool isAtlasTexture() const override
+    {
+        return true;
+    }
+    QRectF normalizedTextureSubRect() const override;
+    QSGTexture *removedFromAtlas() const override;
+    void bind() override;
+
+private:
+    UCIconAtlasTexture(UCIconAtlas *atlas, UCIconAtlasEntry *entry, const QImage &image);
+
+    UCIconAtlas *m_atlas;
+    UCIconAtlasEntry *m_entry;
+    QImage m_image;
+    mutable QSGTexture *m_removedFromAtlas;
+};
+
+// Texture factory of the theme icons, places small icons in the icon atlas.
+class UBUNTUTOOLKIT_EXPORT UCIconTextureFactory : public QQuickTextureFactory
+{
+public:
+    explicit UCIconTextureFactory(const QImage &image);
+
+    QSGTexture *createTexture(QQuickWindow *window) const override;
+    QSize textureSize() const override;
+    int textureByteCount() const override;
+    QImage image() const override;
+
+private:
+    QImage m_image;
+};
+
+UT_NAMESPACE_END
+
+#endif // UCICONATLAS_P_H
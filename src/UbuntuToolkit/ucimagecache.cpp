@@ -0,0 +1,352 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ucimagecache_p.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+#include <QtGui/QGuiApplication>
+#include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qquickimage_p.h>
+#include <QtQuick/private/qquickpixmapcache_p.h>
+
+#include "ucqquickimageextension_p.h"
+
+UT_NAMESPACE_BEGIN
+
+/*!
+    \qmltype ImageCache
+    \instantiates UCImageCache
+    \inqmlmodule Ubuntu.Components
+    \since Ubuntu.Components 1.3
+    \ingroup ubuntu
+    \brief Decodes images and icons ahead of their use.
+
+    Images are decoded lazily, when the items showing them are created. The
+    images the first screens of an application need can be prefetched while
+    the application starts, so that they are ready when the screens are shown.
+    Prefetched images are kept in the image cache of the QML engine until \l
+    clear() is called, the application is suspended or the system runs low on
+    memory.
+
+    \qml
+    import QtQuick 2.4
+    import Ubuntu.Components 1.3
+
+    MainView {
+        Component.onCompleted: {
+            ImageCache.prefetch(["image://theme/add", "image://theme/search"],
+                                Qt.size(units.gu(2), units.gu(2)), Image.PreserveAspectFit);
+            ImageCache.prefetch([Qt.resolvedUrl("background.png")]);
+        }
+    }
+    \endqml
+
+    Images are prefetched the way \l Image and \l Icon load them: \e @gu
+    variants are picked and scaled to the grid unit, and \e .sci files load
+    the image they refer to. An item finds a prefetched image only if it
+    requests it the same way: the size and the fill mode given must match the
+    \c sourceSize and \c fillMode of the items showing the images. \c Icon
+    sets its \c sourceSize to its width and height, and uses
+    \c Image.PreserveAspectFit.
+*/
+UCImageCache::UCImageCache(QQmlEngine *engine, QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_done(0)
+    , m_total(0)
+    , m_loadQueued(false)
+{
+    connect(qGuiApp, &QGuiApplication::applicationStateChanged,
+            this, &UCImageCache::applicationStateChanged);
+}
+
+UCImageCache::~UCImageCache()
+{
+    qDeleteAll(m_loading.keys());
+    qDeleteAll(m_pixmaps);
+}
+
+QObject *UCImageCache::singleton(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(scriptEngine);
+    return new UCImageCache(engine);
+}
+
+/*!
+    \qmlproperty bool ImageCache::running
+    \readonly
+    True while images are being prefetched.
+*/
+
+/*!
+    \qmlproperty real ImageCache::progress
+    \readonly
+    The fraction of the requested images prefetched so far, from 0 to 1.
+*/
+qreal UCImageCache::progress() const
+{
+    return m_total > 0 ? qreal(m_done) / m_total : 1.0;
+}
+
+/*!
+    \qmlproperty int ImageCache::count
+    \readonly
+    The number of prefetched images kept in the cache.
+*/
+
+/*!
+    \qmlsignal ImageCache::finished()
+    Emitted when all the requested images are prefetched.
+*/
+
+/*!
+    \qmlsignal ImageCache::cancelled()
+    Emitted when prefetching is cancelled, by \l cancel() or because the
+    system runs low on memory.
+*/
+
+/*!
+    \qmlmethod ImageCache::prefetch(list<url> urls, size size, enumeration fillMode)
+    Decodes the images at \a urls, at the \a size of the items showing them,
+    in the background. \a fillMode is the \l {Image::fillMode}{fillMode} of
+    these items, \c Image.Stretch by default. Image providers and vector
+    images are decoded at the device pixel ratio of the window, as the items
+    do. Relative urls are resolved against the import path of
+    the engine, use \c Qt.resolvedUrl() to resolve them against a document.
+*/
+void UCImageCache::prefetch(const QVariant &urls, const QSize &size, int fillMode)
+{
+    const QVariantList list = urls.canConvert<QVariantList>() ? urls.toList() : QVariantList() << urls;
+    const bool wasRunning = running();
+    Q_FOREACH(const QVariant &value, list) {
+        QUrl url = value.toUrl();
+        if (url.isEmpty()) {
+            continue;
+        }
+        if (url.isRelative()) {
+            url = m_engine->baseUrl().resolved(url);
+        }
+        const QString key = url.toString() + QLatin1Char('|')
+            + QString::number(size.width()) + QLatin1Char('x') + QString::number(size.height())
+            + QLatin1Char('|') + QString::number(fillMode);
+        if (m_requested.contains(key)) {
+            continue;
+        }
+        m_requested.insert(key);
+        Request request = { url, size, fillMode, key };
+        m_pending.append(request);
+        m_total++;
+    }
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT progressChanged();
+    if (!wasRunning) {
+        Q_EMIT runningChanged();
+    }
+    // wait for the event loop to be idle
+    if (!m_loadQueued) {
+        m_loadQueued = true;
+        QMetaObject::invokeMethod(this, "loadNext", Qt::QueuedConnection);
+    }
+}
+
+/*!
+    \qmlmethod ImageCache::cancel()
+    Stops prefetching. The images prefetched so far are kept.
+*/
+void UCImageCache::cancel()
+{
+    if (!running()) {
+        return;
+    }
+    // keep the keys of the images prefetched so far, so they are not
+    // prefetched again
+    Q_FOREACH(const Request &request, m_pending) {
+        m_requested.remove(request.key);
+    }
+    m_pending.clear();
+    for (auto it = m_loading.constBegin(); it != m_loading.constEnd(); ++it) {
+        m_requested.remove(it.value());
+        delete it.key();
+    }
+    m_loading.clear();
+    m_done = 0;
+    m_total = 0;
+    Q_EMIT runningChanged();
+    Q_EMIT progressChanged();
+    Q_EMIT cancelled();
+}
+
+/*!
+    \qmlmethod ImageCache::clear()
+    Cancels prefetching and releases the prefetched images. The engine keeps
+    them while they are shown, and then for a short while.
+*/
+void UCImageCache::clear()
+{
+    cancel();
+    if (m_pixmaps.isEmpty()) {
+        return;
+    }
+    qDeleteAll(m_pixmaps);
+    m_pixmaps.clear();
+    m_requested.clear();
+    Q_EMIT countChanged();
+}
+
+// Image providers and vector images are loaded at the device pixel ratio when
+// a size is given, like QQuickImageBase does.
+static bool isScalable(const QUrl &url)
+{
+    if (url.scheme() == QLatin1String("image")) {
+        return true;
+    }
+    const QString path = url.path();
+    return path.endsWith(QLatin1String(".svg"), Qt::CaseInsensitive)
+        || path.endsWith(QLatin1String(".svgz"), Qt::CaseInsensitive)
+        || path.endsWith(QLatin1String(".pdf"), Qt::CaseInsensitive);
+}
+
+// The device pixel ratio of the window showing the images, the highest one of
+// the screens if there is none yet.
+static qreal devicePixelRatio()
+{
+    Q_FOREACH(QWindow *window, QGuiApplication::topLevelWindows()) {
+        QQuickWindow *quickWindow = qobject_cast<QQuickWindow*>(window);
+        if (quickWindow && quickWindow->isVisible()) {
+            return quickWindow->effectiveDevicePixelRatio();
+        }
+    }
+    return qGuiApp->devicePixelRatio();
+}
+
+// Starts loading pending images, as many at once as there are cores. Images
+// from providers decode in their own threads, others in the QML engine's
+// image reader thread.
+void UCImageCache::loadNext()
+{
+    m_loadQueued = false;
+    if (!m_pending.isEmpty() && memoryLow()) {
+        cancel();
+        return;
+    }
+
+    const int maximumLoading = qMax(1, QThread::idealThreadCount());
+    while (!m_pending.isEmpty() && m_loading.size() < maximumLoading) {
+        const Request request = m_pending.takeFirst();
+        const QUrl url = UCQQuickImageExtension::resolveSource(request.url, true).url;
+        // request the pixmap as QQuickImage does, for the items to find it in the cache
+        QQuickImageProviderOptions options;
+        options.setPreserveAspectRatioFit(request.fillMode == QQuickImage::PreserveAspectFit);
+        options.setPreserveAspectRatioCrop(request.fillMode == QQuickImage::PreserveAspectCrop);
+        QSize size = request.size;
+        if (size.isValid() && isScalable(url)) {
+            size *= devicePixelRatio();
+        }
+        QQuickPixmap *pixmap = new QQuickPixmap;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        pixmap->load(m_engine, url, QRect(), size, QQuickPixmap::Asynchronous | QQuickPixmap::Cache, options);
+#else
+        pixmap->load(m_engine, url, size, QQuickPixmap::Asynchronous | QQuickPixmap::Cache, options);
+#endif
+        if (pixmap->isLoading()) {
+            pixmap->connectFinished(this, SLOT(pixmapFinished()));
+            m_loading.insert(pixmap, request.key);
+        } else {
+            // already cached, or failed to load
+            m_done++;
+            if (pixmap->isReady()) {
+                m_pixmaps.append(pixmap);
+                Q_EMIT countChanged();
+            } else {
+                m_requested.remove(request.key);
+                delete pixmap;
+            }
+        }
+    }
+    Q_EMIT progressChanged();
+
+    if (!running() && m_total > 0) {
+        m_done = 0;
+        m_total = 0;
+        Q_EMIT runningChanged();
+        Q_EMIT finished();
+    }
+}
+
+void UCImageCache::pixmapFinished()
+{
+    // the reply does not tell which pixmap finished
+    bool changed = false;
+    for (auto it = m_loading.begin(); it != m_loading.end();) {
+        QQuickPixmap *pixmap = it.key();
+        if (pixmap->isLoading()) {
+            ++it;
+            continue;
+        }
+        m_done++;
+        if (pixmap->isReady()) {
+            m_pixmaps.append(pixmap);
+            changed = true;
+        } else {
+            // may be requested again
+            m_requested.remove(it.value());
+            delete pixmap;
+        }
+        it = m_loading.erase(it);
+    }
+    if (changed) {
+        Q_EMIT countChanged();
+    }
+    if (!m_loadQueued) {
+        m_loadQueued = true;
+        QMetaObject::invokeMethod(this, "loadNext", Qt::QueuedConnection);
+    }
+}
+
+// Suspended applications may be killed to reclaim memory, release it first.
+void UCImageCache::applicationStateChanged(Qt::ApplicationState state)
+{
+    if (state == Qt::ApplicationSuspended) {
+        clear();
+    }
+}
+
+// On Linux, the system runs low on memory when less than a tenth of it is
+// available.
+bool UCImageCache::memoryLow() const
+{
+    QFile meminfo(QStringLiteral("/proc/meminfo"));
+    if (!meminfo.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    qint64 total = -1;
+    qint64 available = -1;
+    Q_FOREACH(const QByteArray &line, meminfo.readAll().split('\n')) {
+        if (line.startsWith("MemTotal:")) {
+            total = line.mid(9).trimmed().split(' ').first().toLongLong();
+        } else if (line.startsWith("MemAvailable:")) {
+            available = line.mid(13).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return total > 0 && available >= 0 && available * 10 < total;
+}
+
+UT_NAMESPACE_END
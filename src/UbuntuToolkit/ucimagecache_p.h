@@ -0,0 +1,96 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UCIMAGECACHE_P_H
+#define UCIMAGECACHE_P_H
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QSize>
+#include <QtCore/QUrl>
+#include <QtCore/QVariant>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+QT_FORWARD_DECLARE_CLASS(QQmlEngine)
+QT_FORWARD_DECLARE_CLASS(QJSEngine)
+QT_FORWARD_DECLARE_CLASS(QQuickPixmap)
+
+UT_NAMESPACE_BEGIN
+
+class UBUNTUTOOLKIT_EXPORT UCImageCache : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+public:
+    explicit UCImageCache(QQmlEngine *engine, QObject *parent = 0);
+    ~UCImageCache();
+
+    static QObject *singleton(QQmlEngine *engine, QJSEngine *scriptEngine);
+
+    bool running() const
+    {
+        return !m_pending.isEmpty() || !m_loading.isEmpty();
+    }
+    qreal progress() const;
+    int count() const
+    {
+        return m_pixmaps.size();
+    }
+
+    Q_INVOKABLE void prefetch(const QVariant &urls, const QSize &size = QSize(), int fillMode = 0);
+    Q_INVOKABLE void cancel();
+    Q_INVOKABLE void clear();
+
+Q_SIGNALS:
+    void runningChanged();
+    void progressChanged();
+    void countChanged();
+    void finished();
+    void cancelled();
+
+private Q_SLOTS:
+    void loadNext();
+    void pixmapFinished();
+    void applicationStateChanged(Qt::ApplicationState state);
+
+private:
+    struct Request {
+        QUrl url;
+        QSize size;
+        int fillMode;
+        QString key;
+    };
+
+    bool memoryLow() const;
+
+    QQmlEngine *m_engine;
+    QList<Request> m_pending;
+    QHash<QQuickPixmap*, QString> m_loading; // request keys
+    QList<QQuickPixmap*> m_pixmaps;
+    QSet<QString> m_requested; // pending, loading and kept
+    int m_done;
+    int m_total;
+    bool m_loadQueued;
+};
+
+UT_NAMESPACE_END
+
+#endif // UCIMAGECACHE_P_H
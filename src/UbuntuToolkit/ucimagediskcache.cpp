@@ -0,0 +1,220 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ucimagediskcache_p.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+UT_NAMESPACE_BEGIN
+
+// entry layout: header followed by the pixel rows
+struct UCImageDiskCacheHeader {
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    qint32 sizeWidth;
+    qint32 sizeHeight;
+};
+
+static const quint32 entryMagic = 0x4b544955; // "UITK"
+static const quint32 entryVersion = 1;
+
+struct UCImageDiskCacheMapping {
+    void *data;
+    size_t length;
+};
+
+static void unmapEntry(void *info)
+{
+    UCImageDiskCacheMapping *mapping = static_cast<UCImageDiskCacheMapping*>(info);
+    munmap(mapping->data, mapping->length);
+    delete mapping;
+}
+
+// 32 bit formats, the premultiplied ones are uploaded without conversion
+static bool isStorableFormat(QImage::Format format)
+{
+    return format == QImage::Format_ARGB32_Premultiplied
+        || format == QImage::Format_RGB32
+        || format == QImage::Format_ARGB32;
+}
+
+Q_GLOBAL_STATIC(UCImageDiskCache, imageDiskCache)
+
+UCImageDiskCache::UCImageDiskCache(const QString &path, qint64 maximumSize)
+    : m_path(path)
+    , m_maximumSize(maximumSize)
+    , m_size(-1)
+{
+    if (m_path.isEmpty()) {
+        m_path = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+                + QStringLiteral("/ubuntu-ui-toolkit/images");
+    }
+    m_path += QLatin1Char('/');
+}
+
+// null while the application exits
+UCImageDiskCache *UCImageDiskCache::instance()
+{
+    return imageDiskCache();
+}
+
+QString UCImageDiskCache::key(const QString &path, const QString &parameters)
+{
+    // resources live in the binary and have no reliable modification time
+    if (path.startsWith(QLatin1Char(':'))) {
+        return QString();
+    }
+    const QFileInfo info(path);
+    if (!info.isFile()) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData("\n" + QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    hash.addData("\n" + QByteArray::number(info.size()));
+    hash.addData("\n" + parameters.toUtf8());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QImage UCImageDiskCache::load(const QString &key, QSize *size)
+{
+    if (key.isEmpty()) {
+        return QImage();
+    }
+
+    const QByteArray fileName = QFile::encodeName(m_path + key);
+    int fd = ::open(fileName.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return QImage();
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size < qint64(sizeof(UCImageDiskCacheHeader))) {
+        ::close(fd);
+        return QImage();
+    }
+    // the least recently used entries are evicted first
+    if (status.st_mtime < time(Q_NULLPTR) - 3600) {
+        futimens(fd, Q_NULLPTR);
+    }
+    const size_t length = status.st_size;
+    void *data = mmap(Q_NULLPTR, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return QImage();
+    }
+
+    UCImageDiskCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    const QImage::Format format = QImage::Format(header.format);
+    if (header.magic != entryMagic || header.version != entryVersion
+            || header.width <= 0 || header.height <= 0 || !isStorableFormat(format)
+            || header.bytesPerLine < qint64(header.width) * 4
+            || qint64(sizeof(header)) + qint64(header.bytesPerLine) * header.height > qint64(length)) {
+        munmap(data, length);
+        return QImage();
+    }
+
+    if (size) {
+        *size = QSize(header.sizeWidth, header.sizeHeight);
+    }
+    UCImageDiskCacheMapping *mapping = new UCImageDiskCacheMapping;
+    mapping->data = data;
+    mapping->length = length;
+    // read-only, QImage copies the pixels if they get modified
+    return QImage(static_cast<const uchar*>(data) + sizeof(header), header.width, header.height,
+                  header.bytesPerLine, format, unmapEntry, mapping);
+}
+
+void UCImageDiskCache::store(const QString &key, const QImage &image, const QSize &size)
+{
+    if (key.isEmpty() || image.isNull()) {
+        return;
+    }
+
+    QImage pixels = image;
+    if (!isStorableFormat(pixels.format())) {
+        pixels = pixels.convertToFormat(pixels.hasAlphaChannel()
+                                        ? QImage::Format_ARGB32_Premultiplied
+                                        : QImage::Format_RGB32);
+    }
+    const UCImageDiskCacheHeader header = {
+        entryMagic, entryVersion,
+        pixels.width(), pixels.height(), pixels.bytesPerLine(), pixels.format(),
+        size.width(), size.height()
+    };
+    const qint64 pixelsSize = qint64(pixels.bytesPerLine()) * pixels.height();
+
+    if (!QDir().mkpath(m_path)) {
+        return;
+    }
+    // written aside and renamed, so readers never see a partial entry
+    QSaveFile file(m_path + key);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(pixels.constBits()), pixelsSize);
+    if (!file.commit()) {
+        return;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    if (m_size >= 0) {
+        m_size += sizeof(header) + pixelsSize;
+    }
+    if (m_size < 0 || m_size > m_maximumSize) {
+        evict();
+    }
+}
+
+// Lists the cache and removes the least recently used entries when it is
+// above its maximum size, down to three quarters of it so this does not run
+// on every store. Other processes may share the folder.
+void UCImageDiskCache::evict()
+{
+    const QFileInfoList entries = QDir(m_path).entryInfoList(QDir::Files, QDir::Time);
+    m_size = 0;
+    Q_FOREACH(const QFileInfo &entry, entries) {
+        m_size += entry.size();
+    }
+    if (m_size <= m_maximumSize) {
+        return;
+    }
+    for (int i = entries.size() - 1; i >= 0 && m_size > m_maximumSize * 3 / 4; i--) {
+        if (QFile::remove(entries.at(i).absoluteFilePath())) {
+            m_size -= entries.at(i).size();
+        }
+    }
+}
+
+UT_NAMESPACE_END
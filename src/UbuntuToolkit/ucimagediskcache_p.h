@@ -0,0 +1,64 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UCIMAGEDISKCACHE_P_H
+#define UCIMAGEDISKCACHE_P_H
+
+#include <QtCore/QMutex>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+#include <QtGui/QImage>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+UT_NAMESPACE_BEGIN
+
+/*
+ * Images decoded or rasterized from files, kept across application runs in
+ * $XDG_CACHE_HOME/ubuntu-ui-toolkit/images. Entries are raw 32 bit pixels,
+ * mapped in memory when loaded. Thread safe.
+ */
+class UBUNTUTOOLKIT_EXPORT UCImageDiskCache
+{
+public:
+    explicit UCImageDiskCache(const QString &path = QString(), qint64 maximumSize = 64 * 1024 * 1024);
+
+    static UCImageDiskCache *instance();
+
+    // Returns the key of an image made from the file at @path with @parameters,
+    // or an empty key if the file cannot be cached.
+    static QString key(const QString &path, const QString &parameters);
+
+    QImage load(const QString &key, QSize *size = Q_NULLPTR);
+    void store(const QString &key, const QImage &image, const QSize &size);
+
+    QString path() const
+    {
+        return m_path;
+    }
+
+private:
+    void evict();
+
+    QString m_path;
+    qint64 m_maximumSize;
+    qint64 m_size; // -1 until the cache folder was listed
+    QMutex m_mutex;
+};
+
+UT_NAMESPACE_END
+
+#endif // UCIMAGEDISKCACHE_P_H
@@ -100,7 +100,7 @@ void UCListItemDivider::paletteChanged()
         QColor themeColor;
         UCTheme *theme = d->listItem->getTheme();
         if (theme) {
-            themeColor = d->listItem->getTheme()->getPaletteColor("normal", "base");
+            themeColor = d->listItem->getTheme()->paletteColor(UCTheme::Normal, UCTheme::Base);
         }
         if (!themeColor.isValid()) {
             return;
@@ -331,6 +331,14 @@ void UCListItemPrivate::preStyleChanged()
     UCStyledItemBasePrivate::preStyleChanged();
 }
 
+// the style is kept for another list item, detach it from this one
+void UCListItemPrivate::detachRecycledStyle()
+{
+    if (qobject_cast<UCListItemStyle*>(styleItem)) {
+        listItemStyle()->setListItem(Q_NULLPTR);
+    }
+}
+
 // creates the style item, with altered default value of the animatePanels style property
 // the property is turned on after the panel initialization.
 bool UCListItemPrivate::loadStyleItem(bool animated)
@@ -352,6 +360,8 @@ bool UCListItemPrivate::loadStyleItem(bool animated)
         preStyleChanged();
         return false;
     }
+    // the style may be recycled from another list item
+    myStyle->setListItem(q_func());
     myStyle->updateFlickable(flickable);
     // bring the panels foreground
     styleItem->setZ(0);
@@ -1158,7 +1168,7 @@ QSGNode *UCListItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
     if (paintFocus) {
         QColor penColor;
         if (getTheme()) {
-            penColor = getTheme()->getPaletteColor(isEnabled() ? "normal" : "disabled", "focus");
+            penColor = getTheme()->paletteColor(isEnabled() ? UCTheme::Normal : UCTheme::Disabled, UCTheme::Focus);
         }
         rectNode->setPenColor(penColor);
         rectNode->setColor(Qt::transparent);
@@ -1805,7 +1815,7 @@ void UCListItem::resetHighlightColor()
     d->customColor = false;
     UCTheme *theme = getTheme();
     if (theme) {
-        d->highlightColor = theme->getPaletteColor("highlighted", "background");
+        d->highlightColor = theme->paletteColor(UCTheme::Highlighted, UCTheme::Background);
     }
     update();
     Q_EMIT highlightColorChanged();
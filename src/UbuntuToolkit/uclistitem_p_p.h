@@ -116,6 +116,16 @@ public:
     void setContentMoving(bool moved);
     void preStyleChanged() override;
     bool loadStyleItem(bool animated = true) override;
+    bool canDelayStyleLoading() const override
+    {
+        // the style is post-processed right after loading
+        return false;
+    }
+    bool canRecycleStyle() const override
+    {
+        return true;
+    }
+    void detachRecycledStyle() override;
     bool dragging();
     bool dragMode();
     void setDragMode(bool draggable);
@@ -74,6 +74,7 @@ void UCListItemStyle::componentComplete()
     // look for overridden slots, indexOfMethod returns th elast index of the overridden method
     m_rebound = metaObject()->method(metaObject()->indexOfMethod("rebound()"));
     m_swipeEvent = metaObject()->method(metaObject()->indexOfMethod("swipeEvent(QVariant)"));
+    m_reset = metaObject()->method(metaObject()->indexOfMethod("reset()"));
 //    qDebug() << m_rebound.isValid() << m_swipeEvent.isValid();
 //    for (int i = metaObject()->methodOffset(); i < metaObject()->methodCount(); i++) {
 //        const QMetaMethod method = metaObject()->method(i);
@@ -103,7 +104,8 @@ void UCListItemStyle::componentComplete()
  */
 int UCListItemStyle::index()
 {
-    return UCListItemPrivate::get(m_listItem)->index();
+    // no list item while the style is parked for reuse
+    return m_listItem ? UCListItemPrivate::get(m_listItem)->index() : -1;
 }
 
 /*!
@@ -125,6 +127,38 @@ void UCListItemStyle::updateFlickable(QQuickFlickable *flickable)
     Q_EMIT flickableChanged();
 }
 
+// attaches the style to a list item when reused, or detaches it from the list
+// item being destroyed; the style is reset in both cases
+void UCListItemStyle::setListItem(UCListItem *listItem)
+{
+    if (m_listItem == listItem) {
+        return;
+    }
+    if (!listItem) {
+        // clear the state first, so the stopped animations trigger nothing
+        invokeReset();
+    }
+    if (m_snapAnimation) {
+        if (m_listItem) {
+            disconnect(m_snapAnimation, SIGNAL(runningChanged(bool)),
+                       m_listItem, SLOT(_q_contentMoving()));
+        }
+        m_snapAnimation->stop();
+        if (listItem) {
+            connect(m_snapAnimation, SIGNAL(runningChanged(bool)),
+                    listItem, SLOT(_q_contentMoving()));
+        }
+    }
+    if (m_dropAnimation) {
+        m_dropAnimation->stop();
+    }
+    m_listItem = listItem;
+    if (listItem) {
+        Q_EMIT listItemIndexChanged();
+        invokeReset();
+    }
+}
+
 /*!
  * \qmlmethod ListItemStyle::swipeEvent(SwipeEvent event)
  * The function is called by the ListItem when a swipe action is performed, i.e.
@@ -178,6 +212,30 @@ void UCListItemStyle::invokeRebound()
     }
 }
 
+/*!
+ * \qmlmethod ListItemStyle::reset()
+ * \since Ubuntu.Components.Styles 1.3
+ * Function called when the style of a destroyed ListItem, typically a delegate
+ * of a ListView scrolled out, is kept to be reused by another ListItem. It is
+ * called twice: once the style is detached from the destroyed ListItem, with its
+ * bindings disabled and \c styledItem set to null, then once it is attached to
+ * the new ListItem, with its bindings evaluated against it. Styles must clear
+ * here any state which is not driven by bindings, i.e. state set from scripts,
+ * such as the action triggered, the swipe state or the content of the panels.
+ * The default implementation does nothing.
+ */
+void UCListItemStyle::reset()
+{
+}
+void UCListItemStyle::invokeReset()
+{
+    if (m_reset.isValid()) {
+        m_reset.invoke(this);
+    } else {
+        reset();
+    }
+}
+
 /*!
  * \qmlproperty Animation ListItemStyle::snapAnimation
  * Holds the behavior used in animating when snapped in or out.
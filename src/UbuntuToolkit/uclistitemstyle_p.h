@@ -17,6 +17,7 @@
 #ifndef UCLISTITEMSTYLE_P_H
 #define UCLISTITEMSTYLE_P_H
 
+#include <QtCore/QPointer>
 #include <QtQuick/QQuickItem>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
@@ -83,11 +84,13 @@ public:
 
     void invokeSwipeEvent(UCSwipeEvent *event);
     void invokeRebound();
+    void invokeReset();
     bool animatePanels() const;
     void setAnimatePanels(bool animate);
     int index();
     QQuickFlickable *flickable();
     void updateFlickable(QQuickFlickable *flickable);
+    void setListItem(UCListItem *listItem);
 
 Q_SIGNALS:
     void snapAnimationChanged();
@@ -100,6 +103,7 @@ Q_SIGNALS:
 public Q_SLOTS:
     void swipeEvent(UCSwipeEvent *event);
     void rebound();
+    Q_REVISION(1) void reset();
 
 protected:
     void classBegin() override;
@@ -109,7 +113,8 @@ private:
 
     QMetaMethod m_swipeEvent;
     QMetaMethod m_rebound;
-    UCListItem *m_listItem;
+    QMetaMethod m_reset;
+    QPointer<UCListItem> m_listItem;
     QQuickAbstractAnimation *m_snapAnimation;
     QQuickPropertyAnimation *m_dropAnimation;
     QQuickItem *m_dragPanel;
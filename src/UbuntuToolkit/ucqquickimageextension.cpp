@@ -34,7 +34,8 @@
 
 UT_NAMESPACE_BEGIN
 
-QHash<QUrl, QSharedPointer<QTemporaryFile> > UCQQuickImageExtension::s_rewrittenSciFiles;
+QHash<QString, UCQQuickImageExtension::ScaledSci> UCQQuickImageExtension::s_scaledSciFiles;
+float UCQQuickImageExtension::s_scaledSciGridUnit = 0.0f;
 
 /*!
     \internal
@@ -117,7 +118,8 @@ void UCQQuickImageExtension::reloadSource()
     // If the url we're trying to load is already in the cache and
     // the devicePixelRatio is 1, we save calling UCUnits::resolveResource
     // and just set that image directly.
-    // UCUnits::resolveResource is not cheap (does a stat on disk)
+    // UCUnits::resolveResource lists the directory of the source on first
+    // access, later calls are hash lookups.
     if (qFuzzyCompare(qGuiApp->devicePixelRatio(), (qreal)1.0)) {
         QSize ss = m_image->sourceSize();
         if (ss.isNull() && m_image->image().isNull()) {
@@ -139,102 +141,162 @@ void UCQQuickImageExtension::reloadSource()
         }
     }
 
-    QString resolved = UCUnits::instance()->resolveResource(m_source);
+    const ResolvedSource resolved = resolveSource(m_source, m_image->inherits("QQuickBorderImage"));
+    if (!resolved.sci.source.isEmpty()) {
+        // .sci image file. Set the scaled borders and image on the BorderImage
+        // rather than letting it parse the file.
+        QObject *border = m_image->property("border").value<QObject*>();
+        if (border) {
+            border->setProperty("left", resolved.sci.left);
+            border->setProperty("right", resolved.sci.right);
+            border->setProperty("top", resolved.sci.top);
+            border->setProperty("bottom", resolved.sci.bottom);
+        }
+        m_image->setProperty("horizontalTileMode", int(resolved.sci.horizontalTileMode));
+        m_image->setProperty("verticalTileMode", int(resolved.sci.verticalTileMode));
+    }
+    m_image->setSource(resolved.url);
+    if (resolved.scaled) {
+        // explicitly set the source size in the QQuickImageBase, this persuades it that the
+        // supplied image is suitable for the current devicePixelRatio.
+        m_image->setSourceSize(m_image->sourceSize());
+    }
+}
+
+/*
+    Returns the url to load for @source, with the scaled .sci file content to
+    apply when @borderImage is true and @source is a .sci file.
+*/
+UCQQuickImageExtension::ResolvedSource UCQQuickImageExtension::resolveSource(const QUrl &source, bool borderImage)
+{
+    ResolvedSource result;
+    result.url = source;
+    result.scaled = false;
 
+    QString resolved = UCUnits::instance()->resolveResource(source);
     if (resolved.isEmpty()) {
-        m_image->setSource(m_source);
-        return;
+        return result;
     }
 
     int separatorPosition = resolved.indexOf(QStringLiteral("/"));
     QString scaleFactor = resolved.left(separatorPosition);
     QString selectedFilePath = resolved.mid(separatorPosition+1);
-    QString fragment(m_source.hasFragment() ? "#" + m_source.fragment() : QStringLiteral(""));
+    QString fragment(source.hasFragment() ? "#" + source.fragment() : QStringLiteral(""));
 
-    if (scaleFactor == QStringLiteral("1")) {
+    if (source.path().endsWith(QStringLiteral(".sci"))) {
+        // .sci image file, loads the image it refers to
+        if (borderImage) {
+            result.sci = scaledSci(source, selectedFilePath, scaleFactor);
+            if (!result.sci.source.isEmpty()) {
+                // Take care to pass the original fragment
+                result.url = result.sci.source;
+                if (source.hasFragment()) {
+                    result.url.setFragment(source.fragment());
+                }
+            }
+        }
+        result.scaled = true;
+    } else if (scaleFactor == QStringLiteral("1")) {
         if (qFuzzyCompare(qGuiApp->devicePixelRatio(), (qreal)1.0)
             || selectedFilePath.endsWith(QStringLiteral(".svg"))
             || selectedFilePath.endsWith(QStringLiteral(".svgz"))) {
             // Take care to pass the original fragment
             QUrl selectedFileUrl(QUrl::fromLocalFile(selectedFilePath));
-            if (m_source.hasFragment()) {
-                selectedFileUrl.setFragment(fragment);
+            if (source.hasFragment()) {
+                selectedFileUrl.setFragment(source.fragment());
             }
-            m_image->setSource(selectedFileUrl);
+            result.url = selectedFileUrl;
         } else {
             // Need to scale the pixel-based image to suit the devicePixelRatio setting ourselves.
             // If we let Qt do it, Qt will not choose the UITK-supported "@gu" scaled images.
-            m_image->setSource(QUrl("image://scaling/1/" + selectedFilePath + fragment));
-            // explicitly set the source size in the QQuickImageBase, this persuades it that the
-            // supplied image is suitable for the current devicePixelRatio.
-            m_image->setSourceSize(m_image->sourceSize());
+            result.url = QUrl("image://scaling/1/" + selectedFilePath + fragment);
+            result.scaled = true;
         }
     } else {
         // Prepend "image://scaling" for the image to be loaded by UCScalingImageProvider.
-        if (!m_source.path().endsWith(QStringLiteral(".sci"))) {
-          // Regular image file
-            m_image->setSource(QUrl("image://scaling/" + resolved + fragment));
-        } else {
-            // .sci image file. Rewrite the .sci file into a temporary file.
-            bool rewritten = true;
-            QTemporaryFile* rewrittenSciFile;
-
-            /* Ensure that only one temporary rewritten .sci file is created
-               for each source .sci file by storing the path to the temporary
-               file in a global hash.
-            */
-            rewrittenSciFile = UCQQuickImageExtension::s_rewrittenSciFiles.value(m_source).data();
-            if (rewrittenSciFile == NULL) {
-                rewrittenSciFile = new QTemporaryFile;
-                rewrittenSciFile->setFileTemplate(QDir::tempPath() + "/XXXXXX.sci");
-                rewrittenSciFile->open();
-                QTextStream output(rewrittenSciFile);
+        result.url = QUrl("image://scaling/" + resolved + fragment);
+        result.scaled = true;
+    }
+    return result;
+}
 
-                if (qFuzzyCompare(qGuiApp->devicePixelRatio(), (qreal)1.0)) {
-                    rewritten = rewriteSciFile(selectedFilePath, scaleFactor, output);
-                } else {
-                    QString scaleFactorInDevicePixels = QString::number(scaleFactor.toFloat() / qGuiApp->devicePixelRatio());
-                    rewritten = rewriteSciFile(selectedFilePath, scaleFactorInDevicePixels, output);
-                }
-                rewrittenSciFile->close();
+// Returns the .sci file scaled, from the cache shared by all the images. Entries
+// depend on the grid unit and the device pixel ratio, the cache is emptied
+// when the grid unit changes. The fragment of @source is left to the caller.
+UCQQuickImageExtension::ScaledSci UCQQuickImageExtension::scaledSci(const QUrl &source, const QString &sciFilePath, const QString &scaleFactor)
+{
+    const float gridUnit = UCUnits::instance()->gridUnit();
+    if (gridUnit != s_scaledSciGridUnit) {
+        s_scaledSciFiles.clear();
+        s_scaledSciGridUnit = gridUnit;
+    }
+    const qreal devicePixelRatio = qGuiApp->devicePixelRatio();
+    const QString key = source.toString(QUrl::RemoveFragment) + QLatin1Char('|') + QString::number(gridUnit)
+        + QLatin1Char('|') + QString::number(devicePixelRatio);
 
-                s_rewrittenSciFiles.insert(m_source, QSharedPointer<QTemporaryFile>(rewrittenSciFile));
-            }
+    QHash<QString, ScaledSci>::const_iterator it = s_scaledSciFiles.constFind(key);
+    if (it != s_scaledSciFiles.constEnd()) {
+        return it.value();
+    }
+    ScaledSci sci;
+    if (qFuzzyCompare(devicePixelRatio, (qreal)1.0)) {
+        scaleSciFile(sciFilePath, scaleFactor, &sci);
+    } else {
+        scaleSciFile(sciFilePath, QString::number(scaleFactor.toFloat() / devicePixelRatio), &sci);
+    }
+    s_scaledSciFiles.insert(key, sci);
+    return sci;
+}
 
-            if (rewritten) {
-                // Take care to pass the original fragment
-                QUrl rewrittenSciFileUrl(QUrl::fromLocalFile(rewrittenSciFile->fileName()));
-                rewrittenSciFileUrl.setFragment(fragment);
-                m_image->setSource(rewrittenSciFileUrl);
-            } else {
-                m_image->setSource(m_source);
-            }
-        }
-        // explicitly set the source size in the QQuickImageBase, this persuades it that the
-        // supplied image is suitable for the current devicePixelRatio.
-        m_image->setSourceSize(m_image->sourceSize());
+static Qt::TileRule sciTileMode(QString value)
+{
+    value = value.trimmed().remove(QLatin1Char('"'));
+    if (value.endsWith(QStringLiteral("Repeat"))) {
+        return Qt::RepeatTile;
+    } else if (value.endsWith(QStringLiteral("Round"))) {
+        return Qt::RoundTile;
     }
+    return Qt::StretchTile;
 }
 
-bool UCQQuickImageExtension::rewriteSciFile(const QString &sciFilePath, const QString &scaleFactor, QTextStream& output)
+bool UCQQuickImageExtension::scaleSciFile(const QString &sciFilePath, const QString &scaleFactor, ScaledSci *sci)
 {
     QFile sciFile(sciFilePath);
-    if (sciFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream sciStream(&sciFile);
-        while (!sciStream.atEnd()) {
-            QString line = sciStream.readLine();
-            if (line.startsWith(QStringLiteral("border"))) {
-                output << scaledBorder(line, scaleFactor) << endl;
-            } else if (line.startsWith(QStringLiteral("source"))) {
-                output << scaledSource(line, sciFilePath, scaleFactor) << endl;
-            } else {
-                output << line << endl;
+    if (!sciFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    while (!sciFile.atEnd()) {
+        const QString line = QString::fromUtf8(sciFile.readLine()).trimmed();
+        const int separator = line.indexOf(QLatin1Char(':'));
+        if (separator < 0) {
+            continue;
+        }
+        const QString property = line.left(separator).trimmed();
+        if (property.startsWith(QStringLiteral("border"))) {
+            const QString scaled = scaledBorder(line, scaleFactor);
+            const int value = scaled.mid(scaled.indexOf(QLatin1Char(':')) + 1).toInt();
+            if (property == QStringLiteral("border.left")) {
+                sci->left = value;
+            } else if (property == QStringLiteral("border.right")) {
+                sci->right = value;
+            } else if (property == QStringLiteral("border.top")) {
+                sci->top = value;
+            } else if (property == QStringLiteral("border.bottom")) {
+                sci->bottom = value;
             }
+        } else if (property == QStringLiteral("source")) {
+            const QString scaled = scaledSource(line, sciFilePath, scaleFactor);
+            const int quote = scaled.indexOf(QLatin1Char('"'));
+            sci->source = QUrl(scaled.mid(quote + 1, scaled.lastIndexOf(QLatin1Char('"')) - quote - 1));
+        } else if (property == QStringLiteral("horizontalTileMode")
+                   || property == QStringLiteral("horizontalTileRule")) {
+            sci->horizontalTileMode = sciTileMode(line.mid(separator + 1));
+        } else if (property == QStringLiteral("verticalTileMode")
+                   || property == QStringLiteral("verticalTileRule")) {
+            sci->verticalTileMode = sciTileMode(line.mid(separator + 1));
         }
-        return true;
-    } else {
-        return false;
     }
+    return true;
 }
 
 QString UCQQuickImageExtension::scaledBorder(const QString &border, const QString &scaleFactor)
@@ -21,10 +21,8 @@
 
 #include <QtCore/QEvent>
 #include <QtCore/QByteArray>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
-#include <QtCore/QSharedPointer>
-#include <QtCore/QTemporaryFile>
-#include <QtCore/QTextStream>
 #include <QtCore/QUrl>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
@@ -51,15 +49,38 @@ protected Q_SLOTS:
     void reloadSource();
     void onSourceSizeChanged();
 
-protected:
-    bool rewriteSciFile(const QString &sciFilePath, const QString &scaleFactor, QTextStream& output);
-    QString scaledBorder(const QString &border, const QString &scaleFactor);
-    QString scaledSource(QString source, const QString &sciFilePath, const QString &scaleFactor);
+public:
+    // The content of a .sci file scaled to the grid unit, applied to the
+    // BorderImage instead of the file. The source is empty if it is unreadable.
+    struct ScaledSci {
+        QUrl source;
+        int left = 0;
+        int right = 0;
+        int top = 0;
+        int bottom = 0;
+        Qt::TileRule horizontalTileMode = Qt::StretchTile;
+        Qt::TileRule verticalTileMode = Qt::StretchTile;
+    };
+
+    // The url an image loads for a source.
+    struct ResolvedSource {
+        QUrl url;
+        bool scaled; // sized by UCScalingImageProvider
+        ScaledSci sci;
+    };
+
+    static ResolvedSource resolveSource(const QUrl &source, bool borderImage);
+    static bool scaleSciFile(const QString &sciFilePath, const QString &scaleFactor, ScaledSci *sci);
+    static QString scaledBorder(const QString &border, const QString &scaleFactor);
+    static QString scaledSource(QString source, const QString &sciFilePath, const QString &scaleFactor);
 
 private:
+    static ScaledSci scaledSci(const QUrl &source, const QString &sciFilePath, const QString &scaleFactor);
+
     QQuickImageBase* m_image;
     QUrl m_source;
-    static QHash<QUrl, QSharedPointer<QTemporaryFile> > s_rewrittenSciFiles;
+    static QHash<QString, ScaledSci> s_scaledSciFiles;
+    static float s_scaledSciGridUnit;
 };
 
 UT_NAMESPACE_END
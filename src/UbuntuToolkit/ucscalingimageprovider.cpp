@@ -19,10 +19,170 @@
 #include "ucscalingimageprovider_p.h"
 
 #include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtGui/QImageReader>
 
+#include "ucimagediskcache_p.h"
+
 UT_NAMESPACE_BEGIN
 
+/*
+ * Decodes an image in the decoding thread pool and hands it over to all the
+ * responses waiting for it.
+ */
+class UCScalingImageJob : public QRunnable
+{
+public:
+    UCScalingImageJob(const QString &key, const QString &id, const QSize &requestedSize)
+        : key(key), id(id), requestedSize(requestedSize)
+    {
+    }
+
+    void run() override;
+
+    QString key;
+    QString id;
+    QSize requestedSize;
+    QList<UCScalingImageResponse*> responses; // guarded by the queue mutex
+};
+
+/*
+ * The decoding jobs of all providers. Decoding runs in a pool of its own so it
+ * does not compete with the other QThreadPool users, and identical requests
+ * (same id and requested size) share the decoding.
+ */
+class UCScalingImageQueue
+{
+public:
+    UCScalingImageQueue()
+    {
+        // leave a core for the GUI and render threads
+        pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+    }
+    ~UCScalingImageQueue()
+    {
+        pool.clear();
+        pool.waitForDone();
+    }
+
+    void request(UCScalingImageResponse *response, const QString &id, const QSize &requestedSize);
+    void detach(UCScalingImageResponse *response);
+    bool startJob(UCScalingImageJob *job);
+    void finishJob(UCScalingImageJob *job, const QImage &image, const QString &error);
+
+private:
+    QThreadPool pool;
+    QHash<QString, UCScalingImageJob*> jobs;
+    QMutex mutex;
+};
+Q_GLOBAL_STATIC(UCScalingImageQueue, scalingImageQueue)
+
+void UCScalingImageQueue::request(UCScalingImageResponse *response, const QString &id, const QSize &requestedSize)
+{
+    const QString key = QStringLiteral("%1|%2x%3").arg(id).arg(requestedSize.width()).arg(requestedSize.height());
+
+    QMutexLocker lock(&mutex);
+    UCScalingImageJob *job = jobs.value(key);
+    if (!job) {
+        job = new UCScalingImageJob(key, id, requestedSize);
+        jobs.insert(key, job);
+        pool.start(job);
+    }
+    job->responses.append(response);
+    response->m_job = job;
+}
+
+void UCScalingImageQueue::detach(UCScalingImageResponse *response)
+{
+    QMutexLocker lock(&mutex);
+    UCScalingImageJob *job = response->m_job;
+    if (!job) {
+        return;
+    }
+    response->m_job = Q_NULLPTR;
+    job->responses.removeOne(response);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+    // drop the decoding if nobody waits for it and it did not start yet
+    if (job->responses.isEmpty() && pool.tryTake(job)) {
+        jobs.remove(job->key);
+        delete job;
+    }
+#endif
+}
+
+// returns false if all the requests got cancelled before the decoding started
+bool UCScalingImageQueue::startJob(UCScalingImageJob *job)
+{
+    QMutexLocker lock(&mutex);
+    if (job->responses.isEmpty()) {
+        jobs.remove(job->key);
+        return false;
+    }
+    return true;
+}
+
+void UCScalingImageQueue::finishJob(UCScalingImageJob *job, const QImage &image, const QString &error)
+{
+    QMutexLocker lock(&mutex);
+    jobs.remove(job->key);
+    Q_FOREACH(UCScalingImageResponse *response, job->responses) {
+        response->m_job = Q_NULLPTR;
+        // responses live in the pixmap reader thread
+        QMetaObject::invokeMethod(response, "setImage", Qt::QueuedConnection,
+                                  Q_ARG(QImage, image), Q_ARG(QString, error));
+    }
+}
+
+void UCScalingImageJob::run()
+{
+    UCScalingImageQueue *queue = scalingImageQueue();
+    if (!queue->startJob(this)) {
+        return;
+    }
+    QSize size;
+    QImage image = UCScalingImageProvider::loadImage(id, &size, requestedSize);
+    queue->finishJob(this, image, image.isNull() ? QStringLiteral("Cannot load image %1").arg(id) : QString());
+}
+
+UCScalingImageResponse::UCScalingImageResponse()
+    : m_job(Q_NULLPTR)
+{
+}
+
+UCScalingImageResponse::~UCScalingImageResponse()
+{
+    if (!scalingImageQueue.isDestroyed()) {
+        scalingImageQueue()->detach(this);
+    }
+}
+
+QQuickTextureFactory *UCScalingImageResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+QString UCScalingImageResponse::errorString() const
+{
+    return m_error;
+}
+
+// the Image got destroyed or changed its source
+void UCScalingImageResponse::cancel()
+{
+    scalingImageQueue()->detach(this);
+}
+
+void UCScalingImageResponse::setImage(const QImage &image, const QString &error)
+{
+    m_image = image;
+    m_error = error;
+    Q_EMIT finished();
+}
+
 /*!
     \internal
 
@@ -33,18 +193,49 @@ UT_NAMESPACE_BEGIN
 
     Example:
      * image://scaling/0.5/arrow.png
+
+    Images are decoded in a thread pool of the provider, off the GUI thread,
+    whether or not the Image loads asynchronously.
 */
-UCScalingImageProvider::UCScalingImageProvider() : QQuickImageProvider(QQuickImageProvider::Image)
+UCScalingImageProvider::UCScalingImageProvider()
+    : QQuickAsyncImageProvider()
+{
+}
+
+QQuickImageResponse *UCScalingImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
 {
+    UCScalingImageResponse *response = new UCScalingImageResponse;
+    scalingImageQueue()->request(response, id, requestedSize);
+    return response;
 }
 
 QImage UCScalingImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    return loadImage(id, size, requestedSize);
+}
+
+// thread safe, used by the synchronous and the threaded loading
+QImage UCScalingImageProvider::loadImage(const QString &id, QSize *size, const QSize &requestedSize)
 {
     int separatorPosition = id.indexOf(QStringLiteral("/"));
     float scaleFactor = id.left(separatorPosition).toFloat();
     int fragmentPosition = id.lastIndexOf(QStringLiteral("#"));
     int pathLength = fragmentPosition > -1 ? fragmentPosition - separatorPosition - 1 : -1;
     QString path = id.mid(separatorPosition + 1, pathLength);
+
+    // images scaled by an earlier run are not decoded again
+    UCImageDiskCache *diskCache = UCImageDiskCache::instance();
+    const QString diskKey = diskCache
+            ? UCImageDiskCache::key(path, QStringLiteral("scaling|%1|%2x%3").arg(scaleFactor)
+                                    .arg(requestedSize.width()).arg(requestedSize.height()))
+            : QString();
+    if (!diskKey.isEmpty()) {
+        QImage image = diskCache->load(diskKey, size);
+        if (!image.isNull()) {
+            return image;
+        }
+    }
+
     QFile file(path);
 
     if (file.open(QIODevice::ReadOnly)) {
@@ -77,6 +268,9 @@ QImage UCScalingImageProvider::requestImage(const QString &id, QSize *size, cons
 
         imageReader.read(&image);
         *size = scaledSize;
+        if (!diskKey.isEmpty()) {
+            diskCache->store(diskKey, image, scaledSize);
+        }
         return image;
     } else {
         return QImage();
@@ -26,11 +26,37 @@
 
 UT_NAMESPACE_BEGIN
 
-class UBUNTUTOOLKIT_EXPORT UCScalingImageProvider : public QQuickImageProvider
+class UCScalingImageJob;
+class UBUNTUTOOLKIT_EXPORT UCScalingImageResponse : public QQuickImageResponse
+{
+    Q_OBJECT
+public:
+    explicit UCScalingImageResponse();
+    ~UCScalingImageResponse();
+
+    QQuickTextureFactory *textureFactory() const override;
+    QString errorString() const override;
+    void cancel() override;
+
+private Q_SLOTS:
+    void setImage(const QImage &image, const QString &error);
+
+private:
+    UCScalingImageJob *m_job;
+    QImage m_image;
+    QString m_error;
+
+    friend class UCScalingImageQueue;
+};
+
+class UBUNTUTOOLKIT_EXPORT UCScalingImageProvider : public QQuickAsyncImageProvider
 {
 public:
     explicit UCScalingImageProvider();
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
     QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+    static QImage loadImage(const QString &id, QSize *size, const QSize &requestedSize);
 };
 
 UT_NAMESPACE_END
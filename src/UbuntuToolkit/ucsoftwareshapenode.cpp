@@ -0,0 +1,173 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ucsoftwareshapenode_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QtMath>
+#include <QtGui/QPainter>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/QSGRendererInterface>
+#include <QtQuick/private/qsgtexture_p.h>
+#include <QtQuick/private/qsgsoftwarelayer_p.h>
+#include <QtQuick/private/qsgsoftwarepixmaptexture_p.h>
+
+UT_NAMESPACE_BEGIN
+
+// Corner masks are computed with 4x4 samples per pixel. Shapes mostly share a few radii, the
+// cache is simply cleared when an unusual number of them is used.
+const int cornerMaskSubSamples = 4;
+const int maxCachedCornerMasks = 32;
+
+struct CornerMasks {
+    QImage image[4];  // Top-left, top-right, bottom-left and bottom-right.
+};
+
+static QHash<int, CornerMasks> cornerMasksHash;
+static QMutex cornerMasksHashMutex;
+
+// Gets the masks of the corners of a rounded rectangle, opaque white inside and transparent
+// outside the rounded corners. Masks are shared by the render threads of all the windows.
+static CornerMasks cornerMasks(int radius)
+{
+    QMutexLocker lock(&cornerMasksHashMutex);
+    auto it = cornerMasksHash.constFind(radius);
+    if (it != cornerMasksHash.constEnd()) {
+        return it.value();
+    }
+    if (cornerMasksHash.size() >= maxCachedCornerMasks) {
+        cornerMasksHash.clear();
+    }
+
+    QImage mask(radius, radius, QImage::Format_ARGB32_Premultiplied);
+    const float radiusSquared = static_cast<float>(radius * radius);
+    const int sampleCount = cornerMaskSubSamples * cornerMaskSubSamples;
+    for (int y = 0; y < radius; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(mask.scanLine(y));
+        for (int x = 0; x < radius; x++) {
+            int coverage = 0;
+            for (int j = 0; j < cornerMaskSubSamples; j++) {
+                const float dy = radius - (y + (j + 0.5f) / cornerMaskSubSamples);
+                for (int i = 0; i < cornerMaskSubSamples; i++) {
+                    const float dx = radius - (x + (i + 0.5f) / cornerMaskSubSamples);
+                    if (dx * dx + dy * dy <= radiusSquared) {
+                        coverage++;
+                    }
+                }
+            }
+            const int alpha = (coverage * 255 + sampleCount / 2) / sampleCount;
+            line[x] = qRgba(alpha, alpha, alpha, alpha);
+        }
+    }
+
+    CornerMasks masks;
+    masks.image[0] = mask;
+    masks.image[1] = mask.mirrored(true, false);
+    masks.image[2] = mask.mirrored(false, true);
+    masks.image[3] = mask.mirrored(true, true);
+    cornerMasksHash.insert(radius, masks);
+    return masks;
+}
+
+UCSoftwareShapeNode::UCSoftwareShapeNode(QQuickWindow* window)
+    : QSGRenderNode()
+    , m_window(window)
+{
+}
+
+// static
+bool UCSoftwareShapeNode::isSoftwareRendering(QQuickWindow* window)
+{
+    QSGRendererInterface* rendererInterface = window ? window->rendererInterface() : Q_NULLPTR;
+    return rendererInterface
+        && rendererInterface->graphicsApi() == QSGRendererInterface::Software;
+}
+
+// static
+QPixmap UCSoftwareShapeNode::texturePixmap(QSGTexture* texture)
+{
+    // The software textures aren't exported, check their type by name.
+    if (texture->inherits("QSGSoftwarePixmapTexture")) {
+        return static_cast<QSGSoftwarePixmapTexture*>(texture)->pixmap();
+    } else if (texture->inherits("QSGSoftwareLayer")) {
+        return static_cast<QSGSoftwareLayer*>(texture)->pixmap();
+    } else if (texture->inherits("QSGPlainTexture")) {
+        return QPixmap::fromImage(static_cast<QSGPlainTexture*>(texture)->image());
+    }
+    return QPixmap();
+}
+
+// static
+void UCSoftwareShapeNode::maskCorners(QPainter* painter, const QRect& rect, int radius)
+{
+    radius = qMin(radius, qMin(rect.width(), rect.height()) / 2);
+    if (radius <= 0) {
+        return;
+    }
+
+    const CornerMasks masks = cornerMasks(radius);
+    painter->save();
+    painter->resetTransform();
+    painter->setOpacity(1.0);
+    painter->setCompositionMode(QPainter::CompositionMode_DestinationIn);
+    painter->drawImage(rect.left(), rect.top(), masks.image[0]);
+    painter->drawImage(rect.right() + 1 - radius, rect.top(), masks.image[1]);
+    painter->drawImage(rect.left(), rect.bottom() + 1 - radius, masks.image[2]);
+    painter->drawImage(rect.right() + 1 - radius, rect.bottom() + 1 - radius, masks.image[3]);
+    painter->restore();
+}
+
+QImage* UCSoftwareShapeNode::beginPaint(const QSizeF& itemSize)
+{
+    const qreal dpr = m_window->effectiveDevicePixelRatio();
+    const QSize size(qCeil(itemSize.width() * dpr), qCeil(itemSize.height() * dpr));
+    if (m_image.size() != size) {
+        m_image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    }
+    m_image.fill(Qt::transparent);
+    m_rect = QRectF(QPointF(0.0, 0.0), itemSize);
+    return &m_image;
+}
+
+void UCSoftwareShapeNode::endPaint()
+{
+    // Render nodes are repainted by the software renderer when their material is dirty.
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+void UCSoftwareShapeNode::render(const RenderState* state)
+{
+    if (m_image.isNull()) {
+        return;
+    }
+
+    QPainter* painter = static_cast<QPainter*>(
+        m_window->rendererInterface()->getResource(m_window, QSGRendererInterface::PainterResource));
+    Q_ASSERT(painter);
+
+    // The clip region must be set before the transformation.
+    const QRegion* clipRegion = state->clipRegion();
+    if (clipRegion && !clipRegion->isEmpty()) {
+        painter->setClipRegion(*clipRegion, Qt::ReplaceClip);
+    }
+    painter->setTransform(matrix()->toTransform());
+    painter->setOpacity(inheritedOpacity());
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    painter->drawImage(m_rect, m_image);
+}
+
+UT_NAMESPACE_END
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UCSOFTWARESHAPENODE_P_H
+#define UCSOFTWARESHAPENODE_P_H
+
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
+#include <QtQuick/QSGRenderNode>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+QT_FORWARD_DECLARE_CLASS(QPainter)
+QT_FORWARD_DECLARE_CLASS(QQuickWindow)
+QT_FORWARD_DECLARE_CLASS(QSGTexture)
+
+UT_NAMESPACE_BEGIN
+
+// Node of the shapes rendered with custom OpenGL materials, used in place of them with the
+// software adaptation of the scene graph. Items paint their look in an image whenever they're
+// updated, the node then only blits it.
+class UBUNTUTOOLKIT_EXPORT UCSoftwareShapeNode : public QSGRenderNode
+{
+public:
+    explicit UCSoftwareShapeNode(QQuickWindow* window);
+
+    static bool isSoftwareRendering(QQuickWindow* window);
+
+    // Gets the pixels of a texture created by the software adaptation.
+    static QPixmap texturePixmap(QSGTexture* texture);
+
+    // Masks out the rounded corners of rect on the painter's device, using anti-aliased masks
+    // cached by radius in pixels.
+    static void maskCorners(QPainter* painter, const QRect& rect, int radius);
+
+    // Returns an image cleared to transparent to paint an item of the given size in, at the
+    // device pixel ratio of the window. endPaint() must be called once done.
+    QImage* beginPaint(const QSizeF& itemSize);
+    void endPaint();
+
+    void render(const RenderState* state) override;
+    StateFlags changedStates() const override { return 0; }
+    RenderingFlags flags() const override { return BoundedRectRendering; }
+    QRectF rect() const override { return m_rect; }
+
+private:
+    QQuickWindow* m_window;
+    QImage m_image;
+    QRectF m_rect;
+};
+
+UT_NAMESPACE_END
+
+#endif  // UCSOFTWARESHAPENODE_P_H
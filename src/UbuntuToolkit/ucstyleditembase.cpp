@@ -18,7 +18,15 @@
 
 #include "ucstyleditembase_p_p.h"
 
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+#include <QtGui/QGuiApplication>
 #include <QtQml/QQmlEngine>
+#include <QtQml/QQmlIncubator>
+#include <QtQml/QQmlInfo>
+#include <QtQml/private/qqmlabstractbinding_p.h>
+#include <QtQml/private/qqmldata_p.h>
+#include <QtQuick/QQuickWindow>
 #include <QtQuick/private/qquickanchors_p.h>
 
 #include "ucstylehints_p.h"
@@ -27,16 +35,368 @@
 
 UT_NAMESPACE_BEGIN
 
+// style components between beginCreate() and completeCreate()
+static QSet<QQmlComponent*> stylesUnderCreation;
+
+/*
+ * Incubates the style of a styled item. The incubation is driven by the incubation
+ * controller of the engine, which for the engines used by QQuickView or Window is
+ * the window's one, incubating in the idle time of each frame. Engines without an
+ * incubation controller complete the incubation at once.
+ */
+class UCStyleIncubator : public QQmlIncubator
+{
+public:
+    UCStyleIncubator(UCStyledItemBase *item, QQmlComponent *component, bool animated)
+        : QQmlIncubator(Asynchronous)
+        , item(item)
+        , component(component)
+        , animated(animated)
+    {
+    }
+    ~UCStyleIncubator()
+    {
+        clear();
+    }
+
+    void start()
+    {
+        UCStyledItemBasePrivate *d = UCStyledItemBasePrivate::get(item);
+        component->create(*this, d->styleItemContext);
+    }
+
+    UCStyledItemBase *item;
+    QQmlComponent *component;
+    bool animated;
+
+protected:
+    void setInitialState(QObject *object) override
+    {
+        UCStyledItemBasePrivate::get(item)->initializeStyleItem(object);
+    }
+    void statusChanged(Status status) override
+    {
+        if (status == Ready || status == Error) {
+            UCStyledItemBasePrivate::get(item)->styleIncubated();
+        }
+    }
+};
+
+// items whose style incubation was requested but not yet started
+static QList< QPointer<UCStyledItemBase> > pendingStyleIncubations;
+
+// starts the pending incubations; the incubation controller completes the last
+// started incubation first, so the ones of the items shown on screen are started
+// last, and each group in reverse order of the requests
+static void startPendingStyleIncubations()
+{
+    QList< QPointer<UCStyledItemBase> > pending;
+    pending.swap(pendingStyleIncubations);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = pending.size() - 1; i >= 0; i--) {
+            UCStyledItemBase *item = pending.at(i).data();
+            if (!item) {
+                continue;
+            }
+            UCStyledItemBasePrivate *d = UCStyledItemBasePrivate::get(item);
+            if (!d->styleIncubator || !d->styleIncubator->isNull()) {
+                // cancelled or started already
+                continue;
+            }
+            if ((pass == 1) == d->isShownInWindow()) {
+                d->styleIncubator->start();
+            }
+        }
+    }
+}
+
+static void scheduleStyleIncubation(UCStyledItemBase *item)
+{
+    if (pendingStyleIncubations.isEmpty()) {
+        QTimer::singleShot(0, &startPendingStyleIncubations);
+    }
+    pendingStyleIncubations.append(item);
+}
+
+static bool asynchronousStylesByDefault()
+{
+    static bool asynchronous = qEnvironmentVariableIsSet("UBUNTU_UI_TOOLKIT_ASYNCHRONOUS_STYLES");
+    return asynchronous;
+}
+
+static bool deferredStylesByDefault()
+{
+    static bool deferred = qEnvironmentVariableIsSet("UBUNTU_UI_TOOLKIT_DEFERRED_STYLES");
+    return deferred;
+}
+
+// items loading their style when shown, their hidden styles can be released
+static QSet<UCStyledItemBasePrivate*> deferredStyleItems;
+
+static void trackDeferredStyleItem(UCStyledItemBasePrivate *d, bool track)
+{
+    static bool policyInstalled = false;
+    if (track && !policyInstalled && qGuiApp) {
+        // release the styles not shown when the application goes to the background
+        QObject::connect(qGuiApp, &QGuiApplication::applicationStateChanged, [](Qt::ApplicationState state) {
+            if (state == Qt::ApplicationSuspended) {
+                UCStyledItemBasePrivate::releaseHiddenStyles();
+            }
+        });
+        policyInstalled = true;
+    }
+    if (track) {
+        deferredStyleItems.insert(d);
+    } else {
+        deferredStyleItems.remove(d);
+    }
+}
+
+static const QQuickItemPrivate::ChangeTypes visibilityWatcherChanges =
+        QQuickItemPrivate::Geometry | QQuickItemPrivate::Parent | QQuickItemPrivate::Destroyed;
+
+/*
+ * Watches the changes which may show a styled item waiting for its deferred
+ * style: the geometry of the item and of its ancestors, which includes the
+ * content item of the enclosing Flickables, and the size of the window. The
+ * visibility of the item is followed by the item itself. Each change schedules
+ * a single check for the next frame.
+ */
+class UCStyleVisibilityWatcher : public QObject, public QQuickItemChangeListener
+{
+public:
+    explicit UCStyleVisibilityWatcher(UCStyledItemBasePrivate *d)
+        : d(d)
+    {
+        if (d->window) {
+            connect(d->window, &QWindow::widthChanged, this, &UCStyleVisibilityWatcher::scheduleCheck);
+            connect(d->window, &QWindow::heightChanged, this, &UCStyleVisibilityWatcher::scheduleCheck);
+        }
+        watchAncestors(true);
+    }
+    ~UCStyleVisibilityWatcher()
+    {
+        watchAncestors(false);
+    }
+
+protected:
+    void itemGeometryChanged(QQuickItem *, QQuickGeometryChange, const QRectF &) override
+    {
+        scheduleCheck();
+    }
+    void itemParentChanged(QQuickItem *, QQuickItem *) override
+    {
+        watchAncestors(false);
+        watchAncestors(true);
+        scheduleCheck();
+    }
+    void itemDestroyed(QQuickItem *item) override
+    {
+        ancestors.removeOne(item);
+    }
+
+private:
+    void watchAncestors(bool watch)
+    {
+        if (!watch) {
+            Q_FOREACH(QQuickItem *item, ancestors) {
+                QQuickItemPrivate::get(item)->removeItemChangeListener(this, visibilityWatcherChanges);
+            }
+            ancestors.clear();
+            return;
+        }
+        for (QQuickItem *item = d->q_func(); item; item = item->parentItem()) {
+            QQuickItemPrivate::get(item)->addItemChangeListener(this, visibilityWatcherChanges);
+            ancestors.append(item);
+        }
+    }
+    void scheduleCheck()
+    {
+        d->watchWindowFrames(true);
+    }
+
+    UCStyledItemBasePrivate *d;
+    QList<QQuickItem*> ancestors;
+};
+
+/*
+ * Style items recycled from destroyed styled items, per window and per style
+ * component. The recycling protocol is:
+ * - recyclable styles get a context of their own under the engine's root
+ *   context, so they survive the context of their styled item; the styled item
+ *   is reached through the context object and the styledItem property;
+ * - when a styled item supporting recycling gets deleted, the bindings of its
+ *   style item and of the objects it owns get disabled, their signals blocked
+ *   and their Connections disabled, so that no handler runs while parked; then
+ *   the style item is detached from the styled item and parked in the pool of
+ *   its window;
+ * - a styled item loading its style from a theme component takes a parked style
+ *   of the same component, retargets its context to itself, unblocks the
+ *   handlers, attaches it and re-enables the bindings, which re-evaluates them
+ *   against the new item;
+ * - styled items reset the state not driven by bindings after loading the style.
+ * The pool is bounded, and parked styles are dropped together with their
+ * component or window.
+ */
+class StyleRecyclingPool : public QObject
+{
+public:
+    static const int MaxStylesPerComponent = 16;
+
+    struct Entry {
+        QQuickItem *styleItem;
+        QPointer<QQmlContext> context;
+        QList<QPointer<QObject> > disabledConnections;
+    };
+
+    static StyleRecyclingPool *forWindow(QQuickWindow *window, bool create);
+
+    bool isFull(QQmlComponent *component) const
+    {
+        return m_styles.value(component).size() >= MaxStylesPerComponent;
+    }
+    void park(QQmlComponent *component, const Entry &entry);
+    bool take(QQmlComponent *component, Entry &entry);
+
+private:
+    explicit StyleRecyclingPool(QQuickWindow *window)
+        : QObject(window)
+        , m_window(window)
+    {
+    }
+    ~StyleRecyclingPool()
+    {
+        pools.remove(m_window);
+    }
+    void drop(QQmlComponent *component);
+
+    QHash<QQmlComponent*, QList<Entry> > m_styles;
+    QQuickWindow *m_window;
+    static QHash<QQuickWindow*, StyleRecyclingPool*> pools;
+};
+QHash<QQuickWindow*, StyleRecyclingPool*> StyleRecyclingPool::pools;
+
+StyleRecyclingPool *StyleRecyclingPool::forWindow(QQuickWindow *window, bool create)
+{
+    if (!window) {
+        return Q_NULLPTR;
+    }
+    StyleRecyclingPool *pool = pools.value(window);
+    if (!pool && create) {
+        pool = new StyleRecyclingPool(window);
+        pools.insert(window, pool);
+    }
+    return pool;
+}
+
+void StyleRecyclingPool::park(QQmlComponent *component, const Entry &entry)
+{
+    QHash<QQmlComponent*, QList<Entry> >::iterator i = m_styles.find(component);
+    if (i == m_styles.end()) {
+        i = m_styles.insert(component, QList<Entry>());
+        // theme components get deleted on theme changes, drop their styles too
+        QObject::connect(component, &QObject::destroyed, this, [this, component]() { drop(component); });
+    }
+    QQml_setParent_noEvent(entry.styleItem, this);
+    i.value().append(entry);
+}
+
+bool StyleRecyclingPool::take(QQmlComponent *component, Entry &entry)
+{
+    QHash<QQmlComponent*, QList<Entry> >::iterator i = m_styles.find(component);
+    while (i != m_styles.end() && !i.value().isEmpty()) {
+        entry = i.value().takeLast();
+        if (entry.context) {
+            return true;
+        }
+        delete entry.styleItem;
+    }
+    return false;
+}
+
+void StyleRecyclingPool::drop(QQmlComponent *component)
+{
+    Q_FOREACH(const Entry &entry, m_styles.take(component)) {
+        entry.styleItem->deleteLater();
+    }
+}
+
+// collects the object and the objects it owns
+static void collectStyleObjects(QObject *object, QList<QObject*> *objects)
+{
+    objects->append(object);
+    Q_FOREACH(QObject *child, object->children()) {
+        collectStyleObjects(child, objects);
+    }
+}
+
+// disables or enables the bindings of the objects, enabling a binding evaluates it
+static void setBindingsEnabled(const QList<QObject*> &objects, bool enabled)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+    Q_FOREACH(QObject *object, objects) {
+        QQmlData *ddata = QQmlData::get(object);
+        if (!ddata) {
+            continue;
+        }
+        for (QQmlAbstractBinding *binding = ddata->bindings; binding; binding = binding->nextBinding()) {
+            binding->setEnabled(enabled);
+        }
+    }
+#else
+    Q_UNUSED(objects);
+    Q_UNUSED(enabled);
+#endif
+}
+
+// blocks the signals of the objects and disables their enabled Connections, so
+// that no signal handler runs; the disabled Connections are collected to be
+// enabled again
+static void disableHandlers(const QList<QObject*> &objects, QList<QPointer<QObject> > *disabledConnections)
+{
+    Q_FOREACH(QObject *object, objects) {
+        if (object->inherits("QQmlConnections") && object->property("enabled").toBool()) {
+            object->setProperty("enabled", false);
+            disabledConnections->append(object);
+        }
+    }
+    Q_FOREACH(QObject *object, objects) {
+        object->blockSignals(true);
+    }
+}
+
+static void enableHandlers(const QList<QObject*> &objects, const QList<QPointer<QObject> > &disabledConnections)
+{
+    Q_FOREACH(QObject *object, objects) {
+        object->blockSignals(false);
+    }
+    Q_FOREACH(const QPointer<QObject> &connections, disabledConnections) {
+        if (connections) {
+            connections->setProperty("enabled", true);
+        }
+    }
+}
+
 UCStyledItemBasePrivate::UCStyledItemBasePrivate()
     : oldParentItem(Q_NULLPTR)
     , styleComponent(Q_NULLPTR)
+    , recyclableStyleComponent(Q_NULLPTR)
     , styleItem(Q_NULLPTR)
+    , styleIncubator(Q_NULLPTR)
+    , visibilityWatcher(Q_NULLPTR)
     , styleVersion(0)
     , keyNavigationFocus(false)
     , activeFocusOnPress(false)
     , wasStyleLoaded(false)
     , isFocusScope(true)
+    , loadStyleAsynchronously(asynchronousStylesByDefault())
+    , loadStyleWhenShown(deferredStylesByDefault())
+    , styleLoadPending(false)
+    , pendingStyleAnimated(false)
 {
+    if (loadStyleWhenShown) {
+        trackDeferredStyleItem(this, true);
+    }
 }
 
 /*!
@@ -94,6 +454,9 @@ void UCStyledItemBase::setActiveFocusOnTab2(bool v)
 
 UCStyledItemBasePrivate::~UCStyledItemBasePrivate()
 {
+    trackDeferredStyleItem(this, false);
+    delete styleIncubator;
+    delete visibilityWatcher;
 }
 
 void UCStyledItemBasePrivate::init()
@@ -339,10 +702,154 @@ void UCStyledItemBasePrivate::setStyleName(const QString &name)
     loadStyleItem();
 }
 
+/*!
+ * \qmlproperty bool StyledItem::asynchronousStyle
+ * \since Ubuntu.Components 1.3
+ * When set, the style is created asynchronously, spreading its creation over
+ * several frames, so creating many styled items at once does not block the
+ * user interface. Styles of the items shown on screen are created first. Until
+ * the style is ready the item is shown without a style, therefore bindings
+ * using the style instance must handle its absence. The change takes effect
+ * on the next style creation.
+ *
+ * The default value is \c false, unless the \c UBUNTU_UI_TOOLKIT_ASYNCHRONOUS_STYLES
+ * environment variable is set, in which case all the styles supporting it are
+ * created asynchronously.
+ */
+bool UCStyledItemBasePrivate::asynchronousStyle() const
+{
+    return loadStyleAsynchronously;
+}
+void UCStyledItemBasePrivate::setAsynchronousStyle(bool asynchronous)
+{
+    if (loadStyleAsynchronously == asynchronous) {
+        return;
+    }
+    loadStyleAsynchronously = asynchronous;
+    Q_EMIT q_func()->asynchronousStyleChanged();
+}
+
+/*!
+ * \qmlproperty bool StyledItem::deferredStyle
+ * \since Ubuntu.Components 1.3
+ * When set, the style is created only when the item is first shown, meaning
+ * that it is visible and intersects its window. Items in hidden pages, tabs or
+ * panels, or scrolled out of the window therefore do not pay the style creation
+ * cost until they are revealed. Until then the item has no style, therefore
+ * bindings using the style instance must handle its absence.
+ *
+ * The styles of these items are also released when the application gets
+ * suspended, unless the item is shown. They are recreated when the item is
+ * shown again. Note that suspension, reported as \c Qt.ApplicationSuspended
+ * application state, is the only trigger for this: the styles are not released
+ * on low memory warnings, as the platform does not report those to applications.
+ *
+ * The default value is \c false, unless the \c UBUNTU_UI_TOOLKIT_DEFERRED_STYLES
+ * environment variable is set, in which case all the styles supporting it are
+ * deferred.
+ */
+bool UCStyledItemBasePrivate::deferredStyle() const
+{
+    return loadStyleWhenShown;
+}
+void UCStyledItemBasePrivate::setDeferredStyle(bool deferred)
+{
+    if (loadStyleWhenShown == deferred) {
+        return;
+    }
+    loadStyleWhenShown = deferred;
+    trackDeferredStyleItem(this, deferred);
+    Q_EMIT q_func()->deferredStyleChanged();
+    if (!deferred && styleLoadPending) {
+        _q_loadDeferredStyle();
+    }
+}
+
+/*
+ * Releases the styles of the deferred styled items which are not shown. The
+ * styles are recreated when the items are shown again.
+ */
+void UCStyledItemBasePrivate::releaseHiddenStyles()
+{
+    Q_FOREACH(UCStyledItemBasePrivate *d, deferredStyleItems) {
+        if (!d->styleItem || !d->canDelayStyleLoading() || d->isShownInWindow()) {
+            continue;
+        }
+        d->preStyleChanged();
+        d->deferStyleLoading(false);
+        Q_EMIT d->q_func()->styleInstanceChanged();
+    }
+}
+
+// marks the style loading pending until the item is shown
+void UCStyledItemBasePrivate::deferStyleLoading(bool animated)
+{
+    if (!styleLoadPending) {
+        pendingStyleAnimated = animated;
+    }
+    styleLoadPending = true;
+    watchVisibilityChanges(true);
+    watchWindowFrames(true);
+}
+
+// (re)creates the watcher of the changes which may show the item
+void UCStyledItemBasePrivate::watchVisibilityChanges(bool watch)
+{
+    delete visibilityWatcher;
+    visibilityWatcher = watch ? new UCStyleVisibilityWatcher(this) : Q_NULLPTR;
+}
+
+// checks whether the item got shown on the next frame, when the scene changes settled
+void UCStyledItemBasePrivate::watchWindowFrames(bool watch)
+{
+    Q_Q(UCStyledItemBase);
+    if (watchedWindow && (!watch || watchedWindow != window)) {
+        QObject::disconnect(watchedWindow.data(), SIGNAL(afterAnimating()),
+                            q, SLOT(_q_loadDeferredStyle()));
+        watchedWindow.clear();
+    }
+    if (watch && window && !watchedWindow) {
+        QObject::connect(window, SIGNAL(afterAnimating()),
+                         q, SLOT(_q_loadDeferredStyle()), Qt::DirectConnection);
+        watchedWindow = window;
+    }
+}
+
+// loads the deferred style if the item got shown, otherwise waits for the next change
+void UCStyledItemBasePrivate::_q_loadDeferredStyle()
+{
+    watchWindowFrames(false);
+    if (!styleLoadPending) {
+        watchVisibilityChanges(false);
+        return;
+    }
+    if (loadStyleWhenShown && !isShownInWindow()) {
+        return;
+    }
+    styleLoadPending = false;
+    watchVisibilityChanges(false);
+    loadStyleItem(pendingStyleAnimated);
+}
+
+// returns true if the item is visible and intersects its window
+bool UCStyledItemBasePrivate::isShownInWindow() const
+{
+    Q_Q(const UCStyledItemBase);
+    if (!window || !effectiveVisible) {
+        return false;
+    }
+    QRectF sceneRect = q->mapRectToScene(QRectF(0, 0, width, height));
+    QRectF windowRect(0, 0, window->width(), window->height());
+    // items sized by their style have no size before loading it
+    return sceneRect.isEmpty() ? windowRect.contains(sceneRect.topLeft()) : sceneRect.intersects(windowRect);
+}
+
 // performs pre-style change actions, removes style item size change
 // connections and destroys the style component
 void UCStyledItemBasePrivate::preStyleChanged()
 {
+    cancelStyleIncubation();
+    recyclableStyleComponent = Q_NULLPTR;
     if (styleItem) {
         // make sure the context holder is reset too
         styleItemContext.clear();
@@ -357,42 +864,164 @@ void UCStyledItemBasePrivate::preStyleChanged()
 }
 
 // loads the style animated or not, depending on the loading time
-// returns true on successful style loading
+// returns true on successful style loading; asynchronous loading returns false,
+// the styleInstanceChanged() signal tells when the style is ready
 bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
 {
-    if (styleItem || (!styleComponent && styleDocument.isEmpty()) || !componentComplete) {
+    if (styleItem || styleIncubator || (!styleComponent && styleDocument.isEmpty()) || !componentComplete) {
         // the style loading is delayed
         return false;
     }
+    if (loadStyleWhenShown && canDelayStyleLoading() && !isShownInWindow()) {
+        // load when shown
+        deferStyleLoading(animated);
+        return false;
+    }
+    if (styleLoadPending) {
+        styleLoadPending = false;
+        watchWindowFrames(false);
+        watchVisibilityChanges(false);
+    }
     Q_Q(UCStyledItemBase);
     // either styleComponent or styleName is valid
     QQmlComponent *component = styleComponent;
+    bool temporaryComponent = false;
+    bool asynchronous = loadStyleAsynchronously && canDelayStyleLoading();
     UCTheme *theme = q->getTheme();
     if (!component && theme) {
-        component = theme->createStyleComponent(styleDocument + ".qml", q, styleVersion);
+        component = theme->sharedStyleComponent(styleDocument + ".qml", q, styleVersion);
+        if (component && !asynchronous && stylesUnderCreation.contains(component)) {
+            // a shared component cannot create a new instance before completing the
+            // previous one, which happens when a style contains an item of the same style
+            component = theme->createStyleComponent(styleDocument + ".qml", q, styleVersion);
+            temporaryComponent = true;
+        }
     }
     if (!component) {
         return false;
     }
+    bool recyclable = canRecycleStyle() && component != styleComponent && !temporaryComponent;
+    if (recyclable && reuseStyleItem(component, animated)) {
+        return true;
+    }
     // create context
-    // use creation context as parent to create the context we load the style item with
-    QQmlContext *creationContext = component->creationContext();
+    // use creation context as parent to create the context we load the style item with;
+    // shared theme components have none, their styles are created in the item's context,
+    // recyclable ones in a context of their own, outliving the item's
+    QQmlContext *creationContext = (component == styleComponent || temporaryComponent)
+            ? component->creationContext() : Q_NULLPTR;
+    if (!creationContext && recyclable) {
+        creationContext = qmlEngine(q) ? qmlEngine(q)->rootContext() : Q_NULLPTR;
+    }
     if (!creationContext) {
         creationContext = qmlContext(q);
     }
     if (creationContext && !creationContext->isValid()) {
         // we are having the changes in the component being under deletion
+        if (temporaryComponent) {
+            delete component;
+        }
         return false;
     }
     styleItemContext = new QQmlContext(creationContext);
     styleItemContext->setContextObject(q);
     styleItemContext->setContextProperty(QStringLiteral("styledItem"), q);
     styleItemContext->setContextProperty(QStringLiteral("animated"), animated);
+
+    recyclableStyleComponent = recyclable ? component : Q_NULLPTR;
+    if (asynchronous) {
+        styleIncubator = new UCStyleIncubator(q, component, animated);
+        scheduleStyleIncubation(q);
+        return false;
+    }
+
     QObject *object = component->beginCreate(styleItemContext);
     if (!object) {
         delete styleItemContext;
+        if (temporaryComponent) {
+            delete component;
+        }
         return false;
     }
+    stylesUnderCreation.insert(component);
+    initializeStyleItem(object);
+    if (!styleItem) {
+        delete object;
+    }
+    component->completeCreate();
+    stylesUnderCreation.remove(component);
+    // delete temporary component
+    if (temporaryComponent) {
+        delete component;
+    }
+
+    finalizeStyleItem(animated);
+    return true;
+}
+
+// takes a style item parked in the recycling pool of the window, and attaches it
+bool UCStyledItemBasePrivate::reuseStyleItem(QQmlComponent *component, bool animated)
+{
+    Q_Q(UCStyledItemBase);
+    StyleRecyclingPool *pool = StyleRecyclingPool::forWindow(window, false);
+    StyleRecyclingPool::Entry entry;
+    if (!pool || !pool->take(component, entry)) {
+        return false;
+    }
+    // retarget the context while the bindings are disabled
+    styleItemContext = entry.context;
+    styleItemContext->setContextObject(q);
+    styleItemContext->setContextProperty(QStringLiteral("styledItem"), q);
+    styleItemContext->setContextProperty(QStringLiteral("animated"), animated);
+    QList<QObject*> objects;
+    collectStyleObjects(entry.styleItem, &objects);
+    enableHandlers(objects, entry.disabledConnections);
+    initializeStyleItem(entry.styleItem);
+    recyclableStyleComponent = component;
+    setBindingsEnabled(objects, true);
+    finalizeStyleItem(animated);
+    return true;
+}
+
+// parks the style item in the recycling pool of the window, called when the
+// styled item is about to be deleted
+void UCStyledItemBasePrivate::recycleStyleItem()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+    if (!styleItem || !recyclableStyleComponent || !styleItemContext || !canRecycleStyle()) {
+        return;
+    }
+    // the item may be removed from the scene already
+    StyleRecyclingPool *pool = StyleRecyclingPool::forWindow(window ? window : lastWindow.data(), true);
+    if (!pool || pool->isFull(recyclableStyleComponent)) {
+        // leave the style to be deleted with the item
+        return;
+    }
+    connectStyleSizeChanges(false);
+    StyleRecyclingPool::Entry entry;
+    entry.styleItem = styleItem;
+    entry.context = styleItemContext;
+    QList<QObject*> objects;
+    collectStyleObjects(styleItem, &objects);
+    setBindingsEnabled(objects, false);
+    disableHandlers(objects, &entry.disabledConnections);
+    // do not keep references to the item being deleted
+    styleItemContext->setContextObject(Q_NULLPTR);
+    styleItemContext->setContextProperty(QStringLiteral("styledItem"), QVariant::fromValue<QObject*>(Q_NULLPTR));
+    detachRecycledStyle();
+    QQuickItemPrivate::get(styleItem)->anchors()->resetFill();
+    styleItem->setParentItem(Q_NULLPTR);
+    pool->park(recyclableStyleComponent, entry);
+    styleItem = Q_NULLPTR;
+    styleItemContext.clear();
+    recyclableStyleComponent = Q_NULLPTR;
+#endif
+}
+
+// sets up the style instance before its bindings get evaluated
+void UCStyledItemBasePrivate::initializeStyleItem(QObject *object)
+{
+    Q_Q(UCStyledItemBase);
     // link context to the style item to delete them together
     QQml_setParent_noEvent(styleItemContext, object);
     styleItem = qobject_cast<::QQuickItem*>(object);
@@ -404,17 +1033,15 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
         // anchor fill to the styled component
         QQuickAnchors *styleAnchors = QQuickItemPrivate::get(styleItem)->anchors();
         styleAnchors->setFill(q);
-    } else {
-        delete object;
-    }
-    component->completeCreate();
-    // delete temporary component
-    if (!styleComponent) {
-        delete component;
     }
+}
 
+// completes the style loading once the style instance is complete
+void UCStyledItemBasePrivate::finalizeStyleItem(bool animated)
+{
+    Q_Q(UCStyledItemBase);
     // make sure we reset the animated property to true
-    if (!animated) {
+    if (!animated && styleItemContext) {
         styleItemContext->setContextProperty(QStringLiteral("animated"), true);
     }
 
@@ -422,7 +1049,48 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
     _q_styleResized();
     connectStyleSizeChanges(true);
     Q_EMIT q->styleInstanceChanged();
-    return true;
+}
+
+// called by the incubator when the style incubation is over
+void UCStyledItemBasePrivate::styleIncubated()
+{
+    Q_Q(UCStyledItemBase);
+    UCStyleIncubator *incubator = styleIncubator;
+    styleIncubator = Q_NULLPTR;
+    // the incubator is still reporting its status, delete it afterwards
+    QTimer::singleShot(0, [incubator]() { delete incubator; });
+
+    if (incubator->isError()) {
+        qmlWarning(q) << incubator->errors();
+        if (styleItem) {
+            // partially created, leave it to the incubator
+            styleItem->setParentItem(Q_NULLPTR);
+            styleItem = Q_NULLPTR;
+        }
+        delete styleItemContext.data();
+        return;
+    }
+    QObject *object = incubator->object();
+    if (!styleItem) {
+        delete object;
+    }
+    finalizeStyleItem(incubator->animated);
+}
+
+// aborts the style incubation in progress, destroying the partially created style
+void UCStyledItemBasePrivate::cancelStyleIncubation()
+{
+    if (!styleIncubator) {
+        return;
+    }
+    if (styleItem) {
+        // the partially created style item is deleted by the incubator
+        styleItem->setParentItem(Q_NULLPTR);
+        styleItem = Q_NULLPTR;
+    }
+    delete styleIncubator;
+    styleIncubator = Q_NULLPTR;
+    delete styleItemContext.data();
 }
 
 /*!
@@ -566,12 +1234,42 @@ void UCStyledItemBase::componentComplete()
     d->completeComponentInitialization();
 }
 
+bool UCStyledItemBase::event(QEvent *event)
+{
+    if (event->type() == QEvent::DeferredDelete) {
+        // the item is still functional, last chance to recycle its style
+        d_func()->recycleStyleItem();
+    }
+    return QQuickItem::event(event);
+}
+
 void UCStyledItemBase::itemChange(ItemChange change, const ItemChangeData &data)
 {
     QQuickItem::itemChange(change, data);
     if (change == ItemParentHasChanged) {
         // update parentItem
         d_func()->oldParentItem = data.item;
+    } else if (change == ItemSceneChange) {
+        Q_D(UCStyledItemBase);
+        if (data.window) {
+            d->lastWindow = data.window;
+        }
+        if (d->styleLoadPending) {
+            // follow the item to its new window
+            d->watchVisibilityChanges(true);
+            d->watchWindowFrames(true);
+        }
+        if (data.window && isVisible()) {
+            reloadPendingTheme();
+        }
+    } else if (change == ItemVisibleHasChanged) {
+        Q_D(UCStyledItemBase);
+        if (data.boolValue && d->styleLoadPending) {
+            d->watchWindowFrames(true);
+        }
+        if (data.boolValue && window()) {
+            reloadPendingTheme();
+        }
     } else if (change == ItemActiveFocusHasChanged) {
         // Children may retain focus as if it was the StyledItem itself
         if (!hasActiveFocus())
@@ -48,6 +48,8 @@ class UBUNTUTOOLKIT_EXPORT UCStyledItemBase : public QQuickItem, public UCThemin
     Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), QQmlComponent *style READ style WRITE setStyle RESET resetStyle NOTIFY styleChanged FINAL DESIGNABLE false)
     Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), QQuickItem *__styleInstance READ styleInstance NOTIFY styleInstanceChanged FINAL DESIGNABLE false)
     Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), QString styleName READ styleName WRITE setStyleName NOTIFY styleNameChanged FINAL REVISION 2)
+    Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), bool asynchronousStyle READ asynchronousStyle WRITE setAsynchronousStyle NOTIFY asynchronousStyleChanged FINAL REVISION 2)
+    Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), bool deferredStyle READ deferredStyle WRITE setDeferredStyle NOTIFY deferredStyleChanged FINAL REVISION 2)
     Q_PROPERTY(UT_PREPEND_NAMESPACE(UCTheme) *theme READ getTheme WRITE setTheme RESET resetTheme NOTIFY themeChanged FINAL REVISION 2)
 public:
     explicit UCStyledItemBase(QQuickItem *parent = 0);
@@ -69,6 +71,8 @@ Q_SIGNALS:
     Q_REVISION(1) void activeFocusOnTabChanged2();
     Q_REVISION(2) void themeChanged();
     Q_REVISION(2) void styleNameChanged();
+    Q_REVISION(2) void asynchronousStyleChanged();
+    Q_REVISION(2) void deferredStyleChanged();
 
 protected:
     UCStyledItemBase(UCStyledItemBasePrivate &, QQuickItem *parent);
@@ -79,6 +83,7 @@ protected:
 
     void classBegin() override;
     void componentComplete() override;
+    bool event(QEvent *event) override;
     void itemChange(ItemChange change, const ItemChangeData &data) override;
     void focusInEvent(QFocusEvent *key) override;
     void setKeyNavigationFocus(bool value);
@@ -88,6 +93,7 @@ protected:
 private:
     Q_DECLARE_PRIVATE(UCStyledItemBase)
     Q_PRIVATE_SLOT(d_func(), void _q_styleResized())
+    Q_PRIVATE_SLOT(d_func(), void _q_loadDeferredStyle())
 };
 
 UT_NAMESPACE_END
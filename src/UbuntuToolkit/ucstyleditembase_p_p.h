@@ -21,6 +21,7 @@
 
 #include <UbuntuToolkit/private/ucstyleditembase_p.h>
 
+#include <QtQuick/QQuickWindow>
 #include <QtQuick/private/qquickitem_p.h>
 
 #include <UbuntuToolkit/private/ucthemingextension_p.h>
@@ -31,6 +32,8 @@ class QQuickMouseArea;
 UT_NAMESPACE_BEGIN
 
 class UCStyledItemBase;
+class UCStyleIncubator;
+class UCStyleVisibilityWatcher;
 class UBUNTUTOOLKIT_EXPORT UCStyledItemBasePrivate : public QQuickItemPrivate, public UCImportVersionChecker
 {
     Q_INTERFACES(UT_PREPEND_NAMESPACE(UCThemingExtension))
@@ -42,6 +45,7 @@ public:
     }
 
     void _q_styleResized();
+    void _q_loadDeferredStyle();
 
     UCStyledItemBasePrivate();
     virtual ~UCStyledItemBasePrivate();
@@ -58,10 +62,32 @@ public:
     QString styleName() const;
     void setStyleName(const QString &name);
 
+    bool asynchronousStyle() const;
+    void setAsynchronousStyle(bool asynchronous);
+    bool deferredStyle() const;
+    void setDeferredStyle(bool deferred);
+    static void releaseHiddenStyles();
+    // styled items post-processing their style right after loading it must return false
+    virtual bool canDelayStyleLoading() const
+    {
+        return true;
+    }
+    bool isShownInWindow() const;
+    // styled items whose style can be reused by other items once they get deleted
+    virtual bool canRecycleStyle() const
+    {
+        return false;
+    }
+    // called when the style gets parked for reuse, its bindings and handlers
+    // disabled already
+    virtual void detachRecycledStyle() {}
+    void recycleStyleItem();
+
     virtual void preStyleChanged();
     virtual void postStyleChanged() {}
     virtual bool loadStyleItem(bool animated = true);
     virtual void completeComponentInitialization();
+    void styleIncubated();
 
     // from UCImportVersionChecker
     QString propertyForVersion(quint16 version) const override;
@@ -69,19 +95,37 @@ public:
 public:
 
     QPointer<QQmlContext> styleItemContext;
+    QPointer<QQuickWindow> watchedWindow;
+    QPointer<QQuickWindow> lastWindow;
     QString styleDocument;
     QQuickItem *oldParentItem;
     QQmlComponent *styleComponent;
+    QQmlComponent *recyclableStyleComponent;
     QQuickItem *styleItem;
+    UCStyleIncubator *styleIncubator;
+    UCStyleVisibilityWatcher *visibilityWatcher;
     quint16 styleVersion;
     bool keyNavigationFocus:1;
     bool activeFocusOnPress:1;
     bool wasStyleLoaded:1;
     bool isFocusScope:1;
+    bool loadStyleAsynchronously:1;
+    bool loadStyleWhenShown:1;
+    bool styleLoadPending:1;
+    bool pendingStyleAnimated:1;
 
 protected:
 
     void connectStyleSizeChanges(bool attach);
+    void initializeStyleItem(QObject *object);
+    void finalizeStyleItem(bool animated);
+    void cancelStyleIncubation();
+    void deferStyleLoading(bool animated);
+    void watchVisibilityChanges(bool watch);
+    void watchWindowFrames(bool watch);
+    bool reuseStyleItem(QQmlComponent *component, bool animated);
+
+    friend class UCStyleVisibilityWatcher;
 };
 
 UT_NAMESPACE_END
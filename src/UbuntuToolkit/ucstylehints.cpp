@@ -92,21 +92,56 @@ void UCStyleHintsParser::applyBindings(QObject *obj, QV4::CompiledData::Compilat
         return;
     }
 
-    Q_FOREACH(const QV4::CompiledData::Binding *binding, bindings) {
-        hints->decodeBinding(QString(), compilationUnit, binding);
-    }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    const void *unit = compilationUnit.data();
+#else
+    const void *unit = compilationUnit;
+#endif
+    hints->setProgram(qMakePair(unit, bindings.isEmpty() ? Q_NULLPTR : bindings.first()),
+                      compilationUnit, bindings);
+}
 
-    hints->m_cdata = compilationUnit;
-    hints->m_decoded = true;
+QHash<UCStyleHints::ProgramKey, QWeakPointer<const UCStyleHints::Program> > &UCStyleHints::programCache()
+{
+    // not destroyed, hints may be deleted during application exit
+    static QHash<ProgramKey, QWeakPointer<const Program> > *cache = new QHash<ProgramKey, QWeakPointer<const Program> >;
+    return *cache;
 }
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-void UCStyleHints::decodeBinding(const QString &propertyPrefix, const QQmlRefPointer<QV4::ExecutableCompilationUnit> &compilationUnit, const QV4::CompiledData::Binding *binding)
-#elif QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-void UCStyleHints::decodeBinding(const QString &propertyPrefix, const QQmlRefPointer<QV4::CompiledData::CompilationUnit> &compilationUnit, const QV4::CompiledData::Binding *binding)
+// use the decoded hints of the declaration if another instance has them already
+void UCStyleHints::setProgram(const ProgramKey &key, const CompilationUnitPtr &compilationUnit,
+                              const QList<const QV4::CompiledData::Binding *> &bindings)
+{
+    m_programKey = key;
+    m_program = programCache().value(key).toStrongRef();
+    if (m_program) {
+        return;
+    }
+
+    Program *program = new Program;
+    program->cdata = compilationUnit;
+    // all instances share the location of the declaration
+    QQmlData *ddata = QQmlData::get(this);
+    if (ddata && ddata->outerContext) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 5, 0)
+        QUrl outerContextUrl(ddata->outerContext->url());
 #else
-void UCStyleHints::decodeBinding(const QString &propertyPrefix, const QV4::CompiledData::CompilationUnit *compilationUnit, const QV4::CompiledData::Binding *binding)
+        QUrl outerContextUrl(ddata->outerContext->url);
 #endif
+        if (!outerContextUrl.isEmpty()) {
+            program->url = outerContextUrl;
+            program->line = ddata->lineNumber;
+            program->column = ddata->columnNumber;
+        }
+    }
+    Q_FOREACH(const QV4::CompiledData::Binding *binding, bindings) {
+        decodeBinding(program, QString(), compilationUnit, binding);
+    }
+    m_program = QSharedPointer<const Program>(program);
+    programCache().insert(key, m_program);
+}
+
+void UCStyleHints::decodeBinding(Program *program, const QString &propertyPrefix, const CompilationUnitPtr &compilationUnit, const QV4::CompiledData::Binding *binding)
 {
     QString propertyName = propertyPrefix + compilationUnit->stringAt(binding->propertyNameIndex);
 
@@ -118,7 +153,7 @@ void UCStyleHints::decodeBinding(const QString &propertyPrefix, const QV4::Compi
         const QV4::CompiledData::Binding *subBinding = subObj->bindingTable();
         QString pre = propertyName + ".";
         for (quint32 i = 0; i < subObj->nBindings; ++i, ++subBinding) {
-            decodeBinding(pre, compilationUnit, subBinding);
+            decodeBinding(program, pre, compilationUnit, subBinding);
         }
         return;
     }
@@ -133,24 +168,7 @@ void UCStyleHints::decodeBinding(const QString &propertyPrefix, const QV4::Compi
 #else
         QString expression = binding->valueAsScriptString(compilationUnit->data);
 #endif
-        QUrl url = QUrl();
-        int line = -1;
-        int column = -1;
-
-        QQmlData *ddata = QQmlData::get(this);
-        if (ddata && ddata->outerContext) {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 5, 0)
-            QUrl outerContextUrl(ddata->outerContext->url());
-#else
-            QUrl outerContextUrl(ddata->outerContext->url);
-#endif
-            if (!outerContextUrl.isEmpty()) {
-                url = outerContextUrl;
-                line = ddata->lineNumber;
-                column = ddata->columnNumber;
-            }
-        }
-        m_expressions << Expression(propertyName, binding->value.compiledScriptIndex, expression, url, line, column);
+        program->expressions << Expression(propertyName.toUtf8(), binding->value.compiledScriptIndex, expression);
         break;
     }
     case QV4::CompiledData::Binding::Type_Translation:
@@ -158,28 +176,28 @@ void UCStyleHints::decodeBinding(const QString &propertyPrefix, const QV4::Compi
     case QV4::CompiledData::Binding::Type_String:
     {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-        m_values << qMakePair(propertyName, compilationUnit->bindingValueAsString(binding));
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(compilationUnit->bindingValueAsString(binding)));
 #elif QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-        m_values << qMakePair(propertyName, binding->valueAsString(compilationUnit.data()));
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(binding->valueAsString(compilationUnit.data())));
 #else
-        m_values << qMakePair(propertyName, binding->valueAsString(compilationUnit->data));
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(binding->valueAsString(compilationUnit->data)));
 #endif
         break;
     }
     case QV4::CompiledData::Binding::Type_Number:
     {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-        m_values << qMakePair(propertyName, compilationUnit->bindingValueAsNumber(binding));
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(compilationUnit->bindingValueAsNumber(binding)));
 #elif QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-        m_values << qMakePair(propertyName, binding->valueAsNumber(compilationUnit->constants));
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(binding->valueAsNumber(compilationUnit->constants)));
 #else
-        m_values << qMakePair(propertyName, binding->valueAsNumber());
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(binding->valueAsNumber()));
 #endif
         break;
     }
     case QV4::CompiledData::Binding::Type_Boolean:
     {
-        m_values << qMakePair(propertyName, binding->valueAsBoolean());
+        program->values << qMakePair(propertyName.toUtf8(), QVariant(binding->valueAsBoolean()));
         break;
     }
     }
@@ -232,9 +250,9 @@ void UCStyleHints::propertyNotFound(const QString &styleName, const QString &pro
  */
 UCStyleHints::UCStyleHints(QObject *parent)
     : QObject(parent)
-    , m_decoded(false)
     , m_completed(false)
     , m_ignoreUnknownProperties(true)
+    , m_programKey(Q_NULLPTR, Q_NULLPTR)
 {
 }
 
@@ -242,6 +260,13 @@ UCStyleHints::~UCStyleHints()
 {
     qDeleteAll(m_propertyBackup);
     m_propertyBackup.clear();
+    if (m_program) {
+        m_program.reset();
+        // drop the cache entry with the last instance using it
+        if (programCache().value(m_programKey).isNull()) {
+            programCache().remove(m_programKey);
+        }
+    }
 }
 
 void UCStyleHints::classBegin()
@@ -264,7 +289,7 @@ void UCStyleHints::componentComplete()
 // apply the style hints and check each property existence
 void UCStyleHints::_q_applyStyleHints()
 {
-    if (!m_completed || !m_decoded || !m_styledItem || !UCStyledItemBasePrivate::get(m_styledItem)->styleItem) {
+    if (!m_completed || !m_program || !m_styledItem || !UCStyledItemBasePrivate::get(m_styledItem)->styleItem) {
         return;
     }
 
@@ -275,27 +300,28 @@ void UCStyleHints::_q_applyStyleHints()
     QQuickItem *item = UCStyledItemBasePrivate::get(m_styledItem)->styleItem;
     const QString styleName = UCStyledItemBasePrivate::get(m_styledItem)->styleName();
     // apply values first
-    for (int i = 0; i < m_values.size(); i++) {
-        // Checking the validity of the property using the index of m_values[i].first in
+    for (int i = 0; i < m_program->values.size(); i++) {
+        const QPair<QByteArray, QVariant> &value = m_program->values[i];
+        // Checking the validity of the property using the index of value.first in
         //  item->metaObject is not sufficient in case of a grouped property, so we use
         //  PropertyChange to detect all properties that are not valid.
-        PropertyChange *change = new PropertyChange(item, m_values[i].first.toUtf8());
+        PropertyChange *change = new PropertyChange(item, value.first.constData());
         if (!change->property().isValid()) {
-            propertyNotFound(styleName, m_values[i].first);
+            propertyNotFound(styleName, QString::fromUtf8(value.first));
             delete change;
             continue;
         }
-        PropertyChange::setValue(change, m_values[i].second);
+        PropertyChange::setValue(change, value.second);
         m_propertyBackup << change;
     }
 
     QQmlContext *context = qmlContext(this);
     // then apply expressions/bindings
-    for (int ii = 0; ii < m_expressions.count(); ii++) {
-        Expression e = m_expressions[ii];
-        PropertyChange *change = new PropertyChange(item, e.name.toUtf8());
+    for (int ii = 0; ii < m_program->expressions.count(); ii++) {
+        const Expression &e = m_program->expressions[ii];
+        PropertyChange *change = new PropertyChange(item, e.name.constData());
         if (!change->property().isValid()) {
-            propertyNotFound(styleName, e.name);
+            propertyNotFound(styleName, QString::fromUtf8(e.name));
             delete change;
             continue;
         }
@@ -308,16 +334,16 @@ void UCStyleHints::_q_applyStyleHints()
 #if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
             QV4::Scoped<QV4::QmlContext> qmlContext(scope, QV4::QmlContext::create(scope.engine->rootContext(), cdata, new QObject()));
 #else
-            QV4::ScopedValue function(scope, QV4::QmlBindingWrapper::createQmlCallableForFunction(cdata, item, m_cdata->compilationUnit->runtimeFunctions[e.id]));
+            QV4::ScopedValue function(scope, QV4::QmlBindingWrapper::createQmlCallableForFunction(cdata, item, m_program->cdata->compilationUnit->runtimeFunctions[e.id]));
 #endif
             QQmlPropertyData const *prop = new QQmlPropertyData();
-            newBinding = QQmlBinding::create(prop, m_cdata->runtimeFunctions[e.id], new QObject(), cdata, qmlContext);
+            newBinding = QQmlBinding::create(prop, m_program->cdata->runtimeFunctions[e.id], new QObject(), cdata, qmlContext);
 
 
         }
         if (!newBinding) {
             QQmlPropertyData const *prop = new QQmlPropertyData();
-            newBinding = QQmlBinding::create(prop, e.expression, new QObject(), cdata, e.url.toString(), e.line);
+            newBinding = QQmlBinding::create(prop, e.expression, new QObject(), cdata, m_program->url.toString(), m_program->line);
         }
 
         newBinding->setTarget(change->property());
@@ -19,7 +19,9 @@
 #ifndef UCSTYLEHINTS_P_H
 #define UCSTYLEHINTS_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
 #define foreach Q_FOREACH
 #include <QtQml/private/qpodvector_p.h>
 #include <QtQml/private/qqmlcustomparser_p.h>
@@ -53,42 +55,46 @@ protected:
     void componentComplete() override;
 
 private:
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    typedef QQmlRefPointer<QV4::ExecutableCompilationUnit> CompilationUnitPtr;
+#else
+    typedef QQmlRefPointer<QV4::CompiledData::CompilationUnit> CompilationUnitPtr;
+#endif
     class Expression {
     public:
-        Expression(const QString &name, QQmlBinding::Identifier id, const QString& expr,
-                         const QUrl &url, int line, int column)
-            : name(name), id(id), expression(expr), url(url), line(line), column(column) {}
-        QString name;
+        Expression(const QByteArray &name, QQmlBinding::Identifier id, const QString& expr)
+            : name(name), id(id), expression(expr) {}
+        QByteArray name;
         QQmlBinding::Identifier id;
         QString expression;
+    };
+    // the decoded hints of a StyleHints declaration, shared by all its instances
+    struct Program {
+        Program() : line(-1), column(-1) {}
+        QList<Expression> expressions;
+        QList< QPair<QByteArray, QVariant> > values;
+        CompilationUnitPtr cdata;
         QUrl url;
         int line;
         int column;
     };
+    // programs are identified by their compilation unit and first binding
+    typedef QPair<const void*, const QV4::CompiledData::Binding*> ProgramKey;
 
-    bool m_decoded:1;
     bool m_completed:1;
     bool m_ignoreUnknownProperties:1;
     QPointer<UCStyledItemBase> m_styledItem;
-    QList<Expression> m_expressions;
-    QList< QPair<QString, QVariant> > m_values;
+    QSharedPointer<const Program> m_program;
+    ProgramKey m_programKey;
     QList< PropertyChange* > m_propertyBackup;
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-    QQmlRefPointer<QV4::ExecutableCompilationUnit> m_cdata;
-#else
-    QQmlRefPointer<QV4::CompiledData::CompilationUnit> m_cdata;
-#endif
 
     friend class UCStyleHintsParser;
 
+    static QHash<ProgramKey, QWeakPointer<const Program> > &programCache();
+    void setProgram(const ProgramKey &key, const CompilationUnitPtr &compilationUnit,
+                    const QList<const QV4::CompiledData::Binding *> &bindings);
     void propertyNotFound(const QString &styleName, const QString &property);
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-    void decodeBinding(const QString &propertyPrefix, const QQmlRefPointer<QV4::ExecutableCompilationUnit> &compilationUnit, const QV4::CompiledData::Binding *binding);
-#elif QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-    void decodeBinding(const QString &propertyPrefix, const QQmlRefPointer<QV4::CompiledData::CompilationUnit> &compilationUnit, const QV4::CompiledData::Binding *binding);
-#else
-    void decodeBinding(const QString &propertyPrefix, const QV4::CompiledData::CompilationUnit *compilationUnit, const QV4::CompiledData::Binding *binding);
-#endif
+    void decodeBinding(Program *program, const QString &propertyPrefix, const CompilationUnitPtr &compilationUnit, const QV4::CompiledData::Binding *binding);
 };
 
 class UBUNTUTOOLKIT_EXPORT UCStyleHintsParser : public QQmlCustomParser
@@ -20,8 +20,11 @@
 #include "uctheme_p.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QFileSystemWatcher>
 #include <QtCore/QLibraryInfo>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QTextStream>
 #include <QtGui/QFont>
@@ -148,6 +151,8 @@ UT_NAMESPACE_BEGIN
 static const QString contextTheme = QStringLiteral("theme");
 static const QString themeFolderFormat = QStringLiteral("%1/%2/");
 static const QString parentThemeFile = QStringLiteral("parent_theme");
+static const QString themeManifestFile = QStringLiteral("theme_manifest");
+static const QRegularExpression versionFolder(QStringLiteral("^\\d+\\.\\d+$"));
 
 quint16 UCTheme::previousVersion = 0;
 
@@ -198,39 +203,170 @@ QStringList themeSearchPath()
     return result;
 }
 
-UCTheme::ThemeRecord pathFromThemeName(QString themeName)
+/*
+ * Theme records are resolved once per theme search path and theme name, and are
+ * shared by all the themes. Besides the theme folder, a record holds the index of
+ * the files found in the theme folder and its version folders, so the style lookup
+ * does not need to touch the file system. The index comes from the theme manifest
+ * when the theme has one, otherwise from scanning the theme folder. Records of
+ * scanned themes are dropped when the content of any of their folders changes.
+ */
+class ThemeRecordCache
+{
+public:
+    UCTheme::ThemeRecord record(const QString &themeName);
+    QFileSystemWatcher *watcher();
+
+private:
+    const QStringList &searchPath();
+    UCTheme::ThemeRecord scanTheme(const QString &themeName);
+    bool readManifest(const QString &themeFolder, UCTheme::ThemeRecord &record);
+    void scanFolder(const QString &themeFolder, UCTheme::ThemeRecord &record);
+    void clear();
+
+    QHash<QString, UCTheme::ThemeRecord> m_records;
+    QStringList m_searchPath;
+    QString m_searchPathKey;
+    QPointer<QFileSystemWatcher> m_watcher;
+};
+Q_GLOBAL_STATIC(ThemeRecordCache, themeRecordCache)
+
+QFileSystemWatcher *ThemeRecordCache::watcher()
+{
+    if (!m_watcher) {
+        m_watcher = new QFileSystemWatcher(QCoreApplication::instance());
+        // connected before any theme, so records are dropped by the time themes get notified
+        QObject::connect(m_watcher.data(), &QFileSystemWatcher::directoryChanged,
+                         [this]() { clear(); });
+    }
+    return m_watcher.data();
+}
+
+void ThemeRecordCache::clear()
+{
+    m_records.clear();
+    if (m_watcher && !m_watcher->directories().isEmpty()) {
+        m_watcher->removePaths(m_watcher->directories());
+    }
+}
+
+// the search path only changes when the environment does
+const QStringList &ThemeRecordCache::searchPath()
+{
+    QString key = QString::fromLocal8Bit(getenv("UBUNTU_UI_TOOLKIT_THEMES_PATH"))
+            + '\n' + QString::fromLocal8Bit(getenv("XDG_DATA_DIRS"))
+            + '\n' + QString::fromLocal8Bit(getenv("QML2_IMPORT_PATH"))
+            + '\n' + QDir::currentPath();
+    if (key != m_searchPathKey || m_searchPath.isEmpty()) {
+        m_searchPathKey = key;
+        m_searchPath = themeSearchPath();
+    }
+    return m_searchPath;
+}
+
+UCTheme::ThemeRecord ThemeRecordCache::record(const QString &themeName)
+{
+    const QStringList &pathList = searchPath();
+    QString key = pathList.join(':') + '\n' + themeName;
+    QHash<QString, UCTheme::ThemeRecord>::const_iterator i = m_records.constFind(key);
+    if (i != m_records.constEnd()) {
+        return i.value();
+    }
+    UCTheme::ThemeRecord record = scanTheme(themeName);
+    // do not remember missing themes, those cannot be watched
+    if (record.isValid()) {
+        m_records.insert(key, record);
+    }
+    return record;
+}
+
+UCTheme::ThemeRecord ThemeRecordCache::scanTheme(const QString &themeName)
 {
     // the first entry from pathList is the app's current folder
     UCTheme::ThemeRecord record(themeName, QUrl(), false, false);
-    themeName.replace('.', '/');
-    QStringList pathList = themeSearchPath();
-    Q_FOREACH(const QString &path, pathList) {
-        QString themeFolder = themeFolderFormat.arg(path, themeName);
+    QString themePath = themeName;
+    themePath.replace('.', '/');
+    Q_FOREACH(const QString &path, searchPath()) {
+        QString themeFolder = themeFolderFormat.arg(path, themePath);
         // QUrl needs a trailing slash to understand it's a directory
         QString absoluteThemeFolder = QDir(themeFolder).absolutePath().append('/');
-        if (QDir(absoluteThemeFolder).exists()) {
-            record.deprecated = QFile::exists(absoluteThemeFolder + "deprecated");
-            record.shared = QFile::exists(absoluteThemeFolder + "qmldir");
-            record.path = QUrl::fromLocalFile(absoluteThemeFolder);
-            break;
+        // installed themes come with a manifest, the others need to be scanned
+        if (!readManifest(absoluteThemeFolder, record)) {
+            if (!QDir(absoluteThemeFolder).exists()) {
+                continue;
+            }
+            scanFolder(absoluteThemeFolder, record);
         }
+        record.path = QUrl::fromLocalFile(absoluteThemeFolder);
+        break;
     }
     return record;
 }
 
-QString parentThemeName(const UCTheme::ThemeRecord& themePath)
+/*
+ * Reads the manifest generated for the installed themes by the build, see
+ * features/ubuntu_theme_manifest.prf. Installed themes are not watched.
+ */
+bool ThemeRecordCache::readManifest(const QString &themeFolder, UCTheme::ThemeRecord &record)
 {
-    QString parentTheme;
-    if (!themePath.isValid()) {
-        qWarning() << qPrintable(QStringLiteral("Theme not found: \"%1\"").arg(themePath.name));
-    } else {
-        QFile file(themePath.path.resolved(parentThemeFile).toLocalFile());
+    QFile file(themeFolder + themeManifestFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    Q_FOREACH(const QByteArray &line, lines) {
+        if (line.startsWith("file ")) {
+            record.files.insert(QString::fromUtf8(line.mid(5)));
+        } else if (line.startsWith("parent ")) {
+            record.parentTheme = QString::fromUtf8(line.mid(7).trimmed());
+        } else if (line == "shared") {
+            record.shared = true;
+        } else if (line == "deprecated") {
+            record.deprecated = true;
+        }
+    }
+    return true;
+}
+
+// indexes the theme folder and its version folders, and watches them for changes
+void ThemeRecordCache::scanFolder(const QString &themeFolder, UCTheme::ThemeRecord &record)
+{
+    QStringList folders(themeFolder);
+    Q_FOREACH(const QFileInfo &entry, QDir(themeFolder).entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString fileName = entry.fileName();
+        if (!entry.isDir()) {
+            record.files.insert(fileName);
+        } else if (versionFolder.match(fileName).hasMatch()) {
+            folders << entry.absoluteFilePath();
+            Q_FOREACH(const QString &style, QDir(entry.absoluteFilePath()).entryList(QDir::Files)) {
+                record.files.insert(fileName + '/' + style);
+            }
+        }
+    }
+    watcher()->addPaths(folders);
+
+    record.deprecated = record.files.contains(QStringLiteral("deprecated"));
+    record.shared = record.files.contains(QStringLiteral("qmldir"));
+    if (record.files.contains(parentThemeFile)) {
+        QFile file(themeFolder + parentThemeFile);
         if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
             QTextStream in(&file);
-            parentTheme = in.readLine();
+            record.parentTheme = in.readLine();
         }
     }
-    return parentTheme;
+}
+
+UCTheme::ThemeRecord pathFromThemeName(QString themeName)
+{
+    return themeRecordCache()->record(themeName);
+}
+
+QString parentThemeName(const UCTheme::ThemeRecord& themePath)
+{
+    if (!themePath.isValid()) {
+        qWarning() << qPrintable(QStringLiteral("Theme not found: \"%1\"").arg(themePath.name));
+    }
+    return themePath.parentTheme;
 }
 
 /******************************************************************************
@@ -399,8 +535,11 @@ UCTheme::UCTheme(QObject *parent)
     : QObject(parent)
     , m_parentTheme(Q_NULLPTR)
     , m_palette(Q_NULLPTR)
+    , m_paletteColorsValid(false)
     , m_completed(false)
 {
+    QObject::connect(themeRecordCache()->watcher(), &QFileSystemWatcher::directoryChanged,
+                     this, &UCTheme::_q_themeFolderChanged);
     init();
 }
 
@@ -469,8 +608,16 @@ void UCTheme::_q_defaultThemeChanged()
     Q_EMIT nameChanged();
 }
 
+// the theme folders got changed, refresh the index used by the further style lookups
+void UCTheme::_q_themeFolderChanged()
+{
+    updateThemePaths();
+}
+
 void UCTheme::updateThemePaths()
 {
+    // style components compiled from the previous paths are no longer valid
+    clearStyleCache();
     m_themePaths.clear();
 
     QString themeName = name();
@@ -610,6 +757,8 @@ void UCTheme::setPalette(QObject *config)
         return;
     }
 
+    // the configuration changes palette values in bulk
+    invalidatePaletteColors();
     // 1. restore original palette values
     m_config.restorePalette();
     // 2. clear config list
@@ -634,6 +783,17 @@ void UCTheme::resetPalette()
     setPalette(NULL);
 }
 
+// answers from the theme folder index; files from other sub-folders are not indexed
+static bool themeFileExists(const UCTheme::ThemeRecord &themePath, const QString &relativePath)
+{
+    int slash = relativePath.lastIndexOf('/');
+    if (slash < 0 || versionFolder.match(relativePath.left(slash)).hasMatch()) {
+        return themePath.files.contains(relativePath);
+    }
+    QUrl url = themePath.path.resolved(relativePath);
+    return url.isValid() && QFile::exists(url.toLocalFile());
+}
+
 QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallback)
 {
     if (isFallback) {
@@ -663,8 +823,8 @@ QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallba
             }
 
             QString versionedName = QStringLiteral("%1.%2/%3").arg(major).arg(minor).arg(styleName);
-            styleUrl = themePath.path.resolved(versionedName);
-            if (styleUrl.isValid() && QFile::exists(styleUrl.toLocalFile())) {
+            if (themeFileExists(themePath, versionedName)) {
+                styleUrl = themePath.path.resolved(versionedName);
                 // set fallback warning if the theme is shared
                 if (isFallback && themePath.shared && (version != styleVersion)) {
                     (*isFallback) = true;
@@ -673,11 +833,8 @@ QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallba
             }
 
             // if we don't get any style, get the non-versioned ones for non-shared and deprecated styles
-            if (!themePath.shared || themePath.deprecated) {
-                styleUrl = themePath.path.resolved(styleName);
-                if (styleUrl.isValid() && QFile::exists(styleUrl.toLocalFile())) {
-                    return styleUrl;
-                }
+            if ((!themePath.shared || themePath.deprecated) && themeFileExists(themePath, styleName)) {
+                return themePath.path.resolved(styleName);
             }
         }
     }
@@ -703,23 +860,93 @@ void UCTheme::createDefaultTheme(QQmlEngine* engine)
                      listener, &ContextPropertyChangeListener::updateContextProperty);
 }
 
-void UCTheme::attachItem(QQuickItem *item, bool attach)
+void UCTheme::attachItem(UCThemingExtension *item, bool attach)
 {
+    if (item->themedList) {
+        item->themedList->remove(item);
+    }
     if (attach) {
         m_attachedItems.append(item);
-    } else {
-        m_attachedItems.removeOne(item);
     }
 }
 
+static bool isShown(QQuickItem *item)
+{
+    return item->window() && QQuickItemPrivate::get(item)->effectiveVisible;
+}
+
+/*!
+ * \qmlsignal ThemeSettings::themedItemsReloaded()
+ * The signal is emitted after a theme change, when all the items using the theme
+ * got their styling reloaded. Items shown at the time of the change are reloaded
+ * right away, the rest of the items are reloaded gradually, without blocking the
+ * application.
+ */
+
+/*
+ * Reloads the theme of the attached items. The shown items are reloaded right away,
+ * the hidden ones in time slices on the following event loop iterations, so
+ * switching themes does not block the application. Emits themedItemsReloaded()
+ * when all items got reloaded.
+ */
 void UCTheme::updateThemedItems()
 {
-    for (int i = 0; i < m_attachedItems.count(); i++) {
-        UCThemingExtension *extension = qobject_cast<UCThemingExtension*>(m_attachedItems[i]);
-        if (extension) {
-            extension->itemThemeReloaded(this);
+    while (UCThemingExtension *item = m_attachedItems.first) {
+        m_attachedItems.remove(item);
+        m_pendingItems.append(item);
+    }
+    // pick the shown ones, including the ones pending from a previous reload
+    UCThemedItemList shownItems;
+    UCThemingExtension *next = Q_NULLPTR;
+    for (UCThemingExtension *item = m_pendingItems.first; item; item = next) {
+        next = item->nextThemed;
+        if (isShown(item->themedItem)) {
+            m_pendingItems.remove(item);
+            shownItems.append(item);
+        }
+    }
+    // items may get attached, detached or deleted while reloading
+    while (UCThemingExtension *item = shownItems.first) {
+        shownItems.remove(item);
+        m_attachedItems.append(item);
+        item->itemThemeReloaded(this);
+    }
+
+    if (m_pendingItems.isEmpty()) {
+        m_reloadTimer.stop();
+        Q_EMIT themedItemsReloaded();
+    } else {
+        m_reloadTimer.start(0, this);
+    }
+}
+
+void UCTheme::reloadPendingItems()
+{
+    // leave room for input handling and rendering in the frame
+    static const qint64 sliceTime = 4;
+    QElapsedTimer timer;
+    timer.start();
+    while (UCThemingExtension *item = m_pendingItems.first) {
+        m_pendingItems.remove(item);
+        m_attachedItems.append(item);
+        item->itemThemeReloaded(this);
+        if (timer.elapsed() >= sliceTime) {
+            break;
         }
     }
+    if (m_pendingItems.isEmpty()) {
+        m_reloadTimer.stop();
+        Q_EMIT themedItemsReloaded();
+    }
+}
+
+void UCTheme::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == m_reloadTimer.timerId()) {
+        reloadPendingItems();
+    } else {
+        QObject::timerEvent(event);
+    }
 }
 
 /*
@@ -752,44 +979,114 @@ QQmlComponent* UCTheme::createStyleComponent(const QString& styleName, QObject*
     Q_ASSERT(version);
 
     if (parent != NULL) {
-        QQmlEngine* engine = qmlEngine(parent);
-        if (!engine) {
-            // we may be in the phase when the qml context is not yet defined for the parent
-            // so for now we return NULL
-            return Q_NULLPTR;
-        }
-        // make sure we have the paths
         bool fallback = false;
-        QUrl url = styleUrl(styleName, version, &fallback);
-        if (url.isValid()) {
+        component = compileStyleComponent(styleName, parent, version, &fallback);
+        if (component) {
             if (fallback) {
-                qmlWarning(parent) << QStringLiteral("Theme '%1' has no '%2' style for version %3.%4, fall back to version %5.%6.")
-                                   .arg(name()).arg(styleName).arg(MAJOR_VERSION(version)).arg(MINOR_VERSION(version))
-                                   .arg(MAJOR_VERSION(LATEST_UITK_VERSION)).arg(MINOR_VERSION(LATEST_UITK_VERSION));
-            }
-            component = new QQmlComponent(engine, url, QQmlComponent::PreferSynchronous, parent);
-            if (component->isError()) {
-                qmlWarning(parent) << component->errorString();
-                delete component;
-                component = NULL;
-            } else {
-                // set context for the component
-                QQmlEngine::setContextForObject(component, qmlContext(parent));
+                warnStyleFallback(parent, styleName, version);
             }
-        } else {
-            qmlWarning(parent) <<
-               QStringLiteral("Warning: Style %1 not found in theme %2").arg(styleName).arg(name());
+            component->setParent(parent);
+            // set context for the component
+            QQmlEngine::setContextForObject(component, qmlContext(parent));
         }
     }
 
     return component;
 }
 
+/*
+ * Returns the style component named \a styleName to be used by \a parent. The
+ * component is compiled once per style name and version, and is shared by all
+ * the items using the same style in this theme. It is owned by the theme and gets
+ * discarded when the theme name, the parent theme chain or the engine changes.
+ * The component has no context, styles must be created in the context of the item.
+ */
+QQmlComponent* UCTheme::sharedStyleComponent(const QString& styleName, QObject* parent, quint16 version)
+{
+    Q_ASSERT(version);
+    if (!parent) {
+        return Q_NULLPTR;
+    }
+    QQmlEngine* engine = qmlEngine(parent);
+    if (!engine) {
+        // we may be in the phase when the qml context is not yet defined for the parent
+        // so for now we return NULL
+        return Q_NULLPTR;
+    }
+    if (engine != m_styleCacheEngine) {
+        clearStyleCache();
+        m_styleCacheEngine = engine;
+    }
+
+    const StyleCacheKey key(styleName, version);
+    StyleCacheEntry entry = m_styleCache.value(key);
+    if (!entry.component) {
+        entry.component = compileStyleComponent(styleName, parent, version, &entry.fallback);
+        if (!entry.component) {
+            // do not cache failures so the warnings are shown for each item
+            return Q_NULLPTR;
+        }
+        entry.component->setParent(this);
+        m_styleCache.insert(key, entry);
+    }
+
+    if (entry.fallback) {
+        warnStyleFallback(parent, styleName, version);
+    }
+    return entry.component;
+}
+
+// compiles the style component, reporting the errors on the behalf of the parent
+QQmlComponent* UCTheme::compileStyleComponent(const QString& styleName, QObject* parent, quint16 version,
+                                              bool *isFallback)
+{
+    QQmlEngine* engine = qmlEngine(parent);
+    if (!engine) {
+        // we may be in the phase when the qml context is not yet defined for the parent
+        // so for now we return NULL
+        return Q_NULLPTR;
+    }
+
+    QQmlComponent *component = NULL;
+    // make sure we have the paths
+    QUrl url = styleUrl(styleName, version, isFallback);
+    if (url.isValid()) {
+        component = new QQmlComponent(engine, url, QQmlComponent::PreferSynchronous);
+        if (component->isError()) {
+            qmlWarning(parent) << component->errorString();
+            delete component;
+            component = NULL;
+        }
+    } else {
+        qmlWarning(parent) <<
+           QStringLiteral("Warning: Style %1 not found in theme %2").arg(styleName).arg(name());
+    }
+    return component;
+}
+
+void UCTheme::warnStyleFallback(QObject* parent, const QString& styleName, quint16 version)
+{
+    qmlWarning(parent) << QStringLiteral("Theme '%1' has no '%2' style for version %3.%4, fall back to version %5.%6.")
+                       .arg(name()).arg(styleName).arg(MAJOR_VERSION(version)).arg(MINOR_VERSION(version))
+                       .arg(MAJOR_VERSION(LATEST_UITK_VERSION)).arg(MINOR_VERSION(LATEST_UITK_VERSION));
+}
+
+void UCTheme::clearStyleCache()
+{
+    // style items already created keep working without their component; the
+    // deletion is delayed as the component may still be completing an instance
+    Q_FOREACH(const StyleCacheEntry &entry, m_styleCache) {
+        entry.component->deleteLater();
+    }
+    m_styleCache.clear();
+}
+
 void UCTheme::loadPalette(QQmlEngine *engine, bool notify)
 {
     if (!engine) {
         return;
     }
+    invalidatePaletteColors();
     if (m_palette) {
         // restore bindings to the config palette before we delete
         m_config.restorePalette();
@@ -814,9 +1111,40 @@ void UCTheme::loadPalette(QQmlEngine *engine, bool notify)
     }
 }
 
+// names of the palette profiles and roles, in the order of their enums
+static const char *const paletteProfileNames[UCTheme::PaletteProfileCount] = {
+    "normal", "disabled", "focused", "selected", "selectedDisabled", "highlighted"
+};
+static const char *const paletteRoleNames[UCTheme::PaletteRoleCount] = {
+    "background", "backgroundText", "backgroundSecondaryText", "backgroundTertiaryText",
+    "base", "baseText", "foreground", "foregroundText",
+    "raised", "raisedText", "raisedSecondaryText",
+    "overlay", "overlayText", "overlaySecondaryText",
+    "field", "fieldText", "positive", "positiveText", "negative", "negativeText",
+    "activity", "activityText", "selection", "selectionText",
+    "focus", "focusText", "position", "positionText"
+};
+
+template<int N>
+static int nameIndex(const char *const (&names)[N], const char *name)
+{
+    for (int i = 0; i < N; i++) {
+        if (!qstrcmp(names[i], name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 // returns the palette color value of a color profile
 QColor UCTheme::getPaletteColor(const char *profile, const char *color)
 {
+    int profileIndex = nameIndex(paletteProfileNames, profile);
+    int roleIndex = nameIndex(paletteRoleNames, color);
+    if (profileIndex >= 0 && roleIndex >= 0) {
+        return paletteColor(static_cast<PaletteProfile>(profileIndex), static_cast<PaletteRole>(roleIndex));
+    }
+    // not a palette color known by the toolkit
     QColor result;
     if (palette()) {
         QObject *paletteProfile = m_palette->property(profile).value<QObject*>();
@@ -827,4 +1155,65 @@ QColor UCTheme::getPaletteColor(const char *profile, const char *color)
     return result;
 }
 
+// returns the palette color from the compiled palette, invalid if the palette has no such color
+QColor UCTheme::paletteColor(PaletteProfile profile, PaletteRole role)
+{
+    if (!m_paletteColorsValid || !m_palette) {
+        buildPaletteColors();
+    }
+    if (!(m_paletteRoles[profile] & (1u << role))) {
+        return QColor();
+    }
+    return QColor::fromRgba(m_paletteColors[profile][role]);
+}
+
+// reads all the palette colors at once, and watches the palette values for changes
+void UCTheme::buildPaletteColors()
+{
+    static const QMetaMethod invalidateSlot = staticMetaObject.method(
+                staticMetaObject.indexOfSlot("_q_paletteValuesChanged()"));
+
+    memset(m_paletteRoles, 0, sizeof(m_paletteRoles));
+    m_paletteColorsValid = true;
+    if (!palette()) {
+        return;
+    }
+    const QMetaObject *paletteMeta = m_palette->metaObject();
+    for (int profile = 0; profile < PaletteProfileCount; profile++) {
+        int profileIndex = paletteMeta->indexOfProperty(paletteProfileNames[profile]);
+        if (profileIndex < 0) {
+            continue;
+        }
+        QMetaProperty profileProperty = paletteMeta->property(profileIndex);
+        if (profileProperty.hasNotifySignal()) {
+            connect(m_palette, profileProperty.notifySignal(), this, invalidateSlot, Qt::UniqueConnection);
+        }
+        QObject *values = profileProperty.read(m_palette).value<QObject*>();
+        if (!values) {
+            continue;
+        }
+        const QMetaObject *valuesMeta = values->metaObject();
+        for (int role = 0; role < PaletteRoleCount; role++) {
+            int roleIndex = valuesMeta->indexOfProperty(paletteRoleNames[role]);
+            if (roleIndex < 0) {
+                continue;
+            }
+            QMetaProperty roleProperty = valuesMeta->property(roleIndex);
+            if (roleProperty.hasNotifySignal()) {
+                connect(values, roleProperty.notifySignal(), this, invalidateSlot, Qt::UniqueConnection);
+            }
+            QColor color = roleProperty.read(values).value<QColor>();
+            if (color.isValid()) {
+                m_paletteColors[profile][role] = color.rgba();
+                m_paletteRoles[profile] |= (1u << role);
+            }
+        }
+    }
+}
+
+void UCTheme::_q_paletteValuesChanged()
+{
+    invalidatePaletteColors();
+}
+
 UT_NAMESPACE_END
@@ -20,20 +20,25 @@
 #ifndef UCTHEME_P_H
 #define UCTHEME_P_H
 
+#include <QtCore/QBasicTimer>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QPair>
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtCore/QUrl>
+#include <QtGui/QColor>
 #include <QtQml/QQmlComponent>
 #include <QtQml/QQmlParserStatus>
 #include <QtQml/QQmlProperty>
 #if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
 #include <QtQml/private/qqmlabstractbinding_p.h>
 #endif
-#include <QtQml/private/qpodvector_p.h>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 #include <UbuntuToolkit/private/ucdefaulttheme_p.h>
+#include <UbuntuToolkit/private/ucthemingextension_p.h>
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 6, 0)
 class QQmlAbstractBinding;
@@ -67,10 +72,55 @@ public:
 
         QString name;
         QUrl path;
+        QString parentTheme;
+        // files of the theme folder and its version folders, relative to path
+        QSet<QString> files;
         bool shared:1;
         bool deprecated:1;
     };
 
+    // palette profiles and color roles, matching the Palette and PaletteValues properties
+    enum PaletteProfile {
+        Normal,
+        Disabled,
+        Focused,
+        Selected,
+        SelectedDisabled,
+        Highlighted,
+        PaletteProfileCount
+    };
+    enum PaletteRole {
+        Background,
+        BackgroundText,
+        BackgroundSecondaryText,
+        BackgroundTertiaryText,
+        Base,
+        BaseText,
+        Foreground,
+        ForegroundText,
+        Raised,
+        RaisedText,
+        RaisedSecondaryText,
+        Overlay,
+        OverlayText,
+        OverlaySecondaryText,
+        Field,
+        FieldText,
+        Positive,
+        PositiveText,
+        Negative,
+        NegativeText,
+        Activity,
+        ActivityText,
+        Selection,
+        SelectionText,
+        Focus,
+        FocusText,
+        Position,
+        PositionText,
+        PaletteRoleCount
+    };
+
     explicit UCTheme(QObject *parent = 0);
     static UCTheme *defaultTheme(QQmlEngine *engine);
 
@@ -86,16 +136,24 @@ public:
 
     // internal, used by the deprecated Theme.createStyledComponent()
     QQmlComponent* createStyleComponent(const QString& styleName, QObject* parent, quint16 version = 0);
-    void attachItem(QQuickItem *item, bool attach);
+    // internal, the returned component is owned and cached by the theme
+    QQmlComponent* sharedStyleComponent(const QString& styleName, QObject* parent, quint16 version);
+    void attachItem(UCThemingExtension *item, bool attach);
+    bool isReloadPending(UCThemingExtension *item) const
+    {
+        return item->themedList == &m_pendingItems;
+    }
 
     // helper functions
     QColor getPaletteColor(const char *profile, const char *color);
+    QColor paletteColor(PaletteProfile profile, PaletteRole role);
 
 Q_SIGNALS:
     void parentThemeChanged();
     void nameChanged();
     void paletteChanged();
     void versionChanged();
+    void themedItemsReloaded();
 
 protected:
     void classBegin() override;
@@ -103,10 +161,13 @@ protected:
     {
         m_completed = true;
     }
+    void timerEvent(QTimerEvent *event) override;
 
 private Q_SLOTS:
     void resetPalette();
     void _q_defaultThemeChanged();
+    void _q_themeFolderChanged();
+    void _q_paletteValuesChanged();
 
 private:
     static void createDefaultTheme(QQmlEngine* engine);
@@ -115,8 +176,18 @@ private:
     void updateEnginePaths(QQmlEngine *engine);
     void updateThemePaths();
     QUrl styleUrl(const QString& styleName, quint16 version, bool *isFallback = NULL);
+    QQmlComponent* compileStyleComponent(const QString& styleName, QObject* parent, quint16 version,
+                                         bool *isFallback);
+    void warnStyleFallback(QObject* parent, const QString& styleName, quint16 version);
+    void clearStyleCache();
     void loadPalette(QQmlEngine *engine, bool notify = true);
+    void buildPaletteColors();
+    void invalidatePaletteColors()
+    {
+        m_paletteColorsValid = false;
+    }
     void updateThemedItems();
+    void reloadPendingItems();
 
     class PaletteConfig
     {
@@ -167,13 +238,31 @@ private:
         QList<Data> configList;
     };
 
+    // compiled style components by style name and version
+    struct StyleCacheEntry {
+        StyleCacheEntry()
+            : component(Q_NULLPTR), fallback(false)
+        {}
+        QQmlComponent *component;
+        bool fallback;
+    };
+    typedef QPair<QString, quint16> StyleCacheKey;
+
     PaletteConfig m_config;
+    QHash<StyleCacheKey, StyleCacheEntry> m_styleCache;
+    QPointer<QQmlEngine> m_styleCacheEngine;
     QString m_name;
     QPointer<UCTheme> m_parentTheme;
     QPointer<QObject> m_palette; // the palette might be from the default style if the theme doesn't define palette
     QList<ThemeRecord> m_themePaths;
+    // palette colors, compiled on demand after each palette change
+    QRgb m_paletteColors[PaletteProfileCount][PaletteRoleCount];
+    quint32 m_paletteRoles[PaletteProfileCount]; // bit set if the role is defined
+    bool m_paletteColorsValid:1;
     UCDefaultTheme m_defaultTheme;
-    QPODVector<QQuickItem*, 4> m_attachedItems;
+    UCThemedItemList m_attachedItems;
+    UCThemedItemList m_pendingItems; // items waiting for their theme reload
+    QBasicTimer m_reloadTimer;
     bool m_completed:1;
 
     friend class UCDeprecatedTheme;
@@ -167,12 +167,56 @@ void UCItemAttached::itemParentChanged(QQuickItem *, QQuickItem *newParent)
     m_prevParent = newParent;
 }
 
+/*************************************************************************
+ * Intrusive list of themed items
+ */
+void UCThemedItemList::append(UCThemingExtension *item)
+{
+    Q_ASSERT(!item->themedList);
+    item->themedList = this;
+    item->previousThemed = last;
+    item->nextThemed = Q_NULLPTR;
+    if (last) {
+        last->nextThemed = item;
+    } else {
+        first = item;
+    }
+    last = item;
+}
+
+void UCThemedItemList::remove(UCThemingExtension *item)
+{
+    Q_ASSERT(item->themedList == this);
+    if (item->previousThemed) {
+        item->previousThemed->nextThemed = item->nextThemed;
+    } else {
+        first = item->nextThemed;
+    }
+    if (item->nextThemed) {
+        item->nextThemed->previousThemed = item->previousThemed;
+    } else {
+        last = item->previousThemed;
+    }
+    item->themedList = Q_NULLPTR;
+    item->previousThemed = item->nextThemed = Q_NULLPTR;
+}
+
+void UCThemedItemList::clear()
+{
+    while (first) {
+        remove(first);
+    }
+}
+
 /*************************************************************************
  *
  */
 UCThemingExtension::UCThemingExtension(QQuickItem *extendedItem)
     : theme(Q_NULLPTR)
     , themedItem(extendedItem)
+    , themedList(Q_NULLPTR)
+    , previousThemed(Q_NULLPTR)
+    , nextThemed(Q_NULLPTR)
     , themeType(Inherited)
 {
     themedItem->setUserData(xdata, new UCItemAttached(themedItem));
@@ -181,7 +225,7 @@ UCThemingExtension::UCThemingExtension(QQuickItem *extendedItem)
 UCThemingExtension::~UCThemingExtension()
 {
     if (theme) {
-        theme->attachItem(themedItem, false);
+        theme->attachItem(this, false);
     }
 }
 
@@ -239,6 +283,15 @@ void UCThemingExtension::itemThemeReloaded(UCTheme *theme)
     }
 }
 
+// reloads the theme of an item shown before its turn in a time-sliced theme reload
+void UCThemingExtension::reloadPendingTheme()
+{
+    if (theme && theme->isReloadPending(this)) {
+        theme->attachItem(this, true);
+        itemThemeReloaded(theme);
+    }
+}
+
 UCTheme *UCThemingExtension::getTheme()
 {
     if (!theme) {
@@ -250,7 +303,7 @@ UCTheme *UCThemingExtension::getTheme()
             qCritical().noquote() << msg;
             return Q_NULLPTR;
         }
-        theme->attachItem(themedItem, true);
+        theme->attachItem(this, true);
     }
     return theme;
 }
@@ -268,14 +321,14 @@ void UCThemingExtension::setTheme(UCTheme *newTheme, ThemeType type)
 
     // disconnect from the previous set
     if (theme) {
-        theme->attachItem(themedItem, false);
+        theme->attachItem(this, false);
     }
 
     theme = newTheme;
 
     // connect to the new set
     if (theme) {
-        theme->attachItem(themedItem, true);
+        theme->attachItem(this, true);
         // set the parent of the theme if custom
         setParentTheme();
     }
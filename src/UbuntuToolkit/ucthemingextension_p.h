@@ -32,6 +32,32 @@ class QQuickItem;
 UT_NAMESPACE_BEGIN
 
 class UCTheme;
+class UCThemingExtension;
+
+// intrusive list of themed items, attaching and detaching an item is O(1)
+class UBUNTUTOOLKIT_EXPORT UCThemedItemList
+{
+public:
+    UCThemedItemList()
+        : first(Q_NULLPTR), last(Q_NULLPTR)
+    {}
+    ~UCThemedItemList()
+    {
+        clear();
+    }
+
+    void append(UCThemingExtension *item);
+    void remove(UCThemingExtension *item);
+    void clear();
+    bool isEmpty() const
+    {
+        return !first;
+    }
+
+    UCThemingExtension *first;
+    UCThemingExtension *last;
+};
+
 class UBUNTUTOOLKIT_EXPORT UCThemingExtension
 {
 public:
@@ -55,12 +81,22 @@ public:
     static bool isThemed(QQuickItem *item);
     static QQuickItem *ascendantThemed(QQuickItem *item);
 
+protected:
+    void reloadPendingTheme();
+
 private:
     QPointer<UCTheme> theme;
     QQuickItem *themedItem;
+    // links in the theme's list of attached items
+    UCThemedItemList *themedList;
+    UCThemingExtension *previousThemed;
+    UCThemingExtension *nextThemed;
     ThemeType themeType;
 
     void setParentTheme();
+
+    friend class UCTheme;
+    friend class UCThemedItemList;
 };
 
 UT_NAMESPACE_END
@@ -29,8 +29,11 @@
 
 #include <math.h>
 
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
 #include <QtCore/QPointer>
 #include <QtGui/QGuiApplication>
+#include <QtGui/QPainter>
 #include <QtQml/QQmlInfo>
 #include <QtQuick/private/qsgadaptationlayer_p.h>
 // This private header uses the emit keyword while we build with QT_NO_KEYWORDS set. See #1507910.
@@ -40,6 +43,7 @@
 
 #include "quickutils_p.h"
 #include "ubuntutoolkitglobal.h"
+#include "ucsoftwareshapenode_p.h"
 #include "ucunits_p.h"
 
 UT_NAMESPACE_BEGIN
@@ -69,7 +73,7 @@ char const* const* ShapeShader::attributeNames() const
 {
     static char const* const attributes[] = {
         "positionAttrib", "shapeCoordAttrib", "sourceCoordAttrib", "yCoordAttrib",
-        "backgroundColorAttrib", 0
+        "backgroundColorAttrib", "parametersAttrib", 0
     };
     return attributes;
 }
@@ -85,10 +89,16 @@ void ShapeShader::initialize()
     m_functions = QOpenGLContext::currentContext()->functions();
     m_matrixId = program()->uniformLocation("matrix");
     m_opacityFactorsId = program()->uniformLocation("opacityFactors");
-    m_sourceOpacityId = program()->uniformLocation("sourceOpacity");
-    m_distanceAAId = program()->uniformLocation("distanceAA");
+    m_distanceAAId = program()->uniformLocation("distanceAAScale");
     m_texturedId = program()->uniformLocation("textured");
     m_aspectId = program()->uniformLocation("aspect");
+
+    if (useDistanceFields()) {
+        // Send anti-aliasing distance in distance field space, needs to be divided by 2 for the
+        // shader. The vertex shader scales it by the per-shape anti-aliasing distance factor.
+        const float distanceAA = (shapeTextureDistanceAA * distanceAApx) / 2.0f;
+        program()->setUniformValue(m_distanceAAId, distanceAA);
+    }
 }
 
 void ShapeShader::updateState(
@@ -124,7 +134,6 @@ void ShapeShader::updateState(
             m_functions->glActiveTexture(GL_TEXTURE1);
             sourceTexture->bind();
             m_functions->glActiveTexture(GL_TEXTURE0);
-            program()->setUniformValue(m_sourceOpacityId, data->sourceOpacity / 255.0f);
             textured = true;
         }
     }
@@ -141,15 +150,6 @@ void ShapeShader::updateState(
         data->flags & ShapeMaterial::Data::Pressed ? pressedFactor * opacity : opacity, opacity);
     program()->setUniformValue(m_opacityFactorsId, opacityFactorsVector);
 
-    if (useDistanceFields()) {
-        // Send anti-aliasing distance in distance field space, needs to be divided by 2 for the
-        // shader and by 255 for distanceAAFactor dequantization. The factor is 1 most of the time
-        // apart when the radius size is low, it linearly goes from 1 to 0 to make the corners
-        // prettier and to prevent the opacity of the whole shape to slightly lower.
-        const float distanceAA = (shapeTextureDistanceAA * distanceAApx) / (2.0 * 255.0f);
-        program()->setUniformValue(m_distanceAAId, data->distanceAAFactor * distanceAA);
-    }
-
     // Update QtQuick engine uniforms.
     if (state.isMatrixDirty()) {
         program()->setUniformValue(m_matrixId, state.combinedMatrix());
@@ -175,7 +175,16 @@ static void createShapeTextures(QOpenGLContext* openglContext, quint32* ids)
                          GL_RGBA, GL_UNSIGNED_BYTE, shapeTextureData[i]);
         }
     } else {
-        // Create mipmap textures.
+        // Create mipmap textures. The data is only loaded from the resource on first use and
+        // released once uploaded.
+        QFile file(QString::fromLatin1(shapeTextureMipmapResource));
+        const QByteArray data = file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+        const char* mipmapData = Q_NULLPTR;
+        if (data.size() == shapeTextureCount * shapeTextureMipmapSize) {
+            mipmapData = data.constData();
+        } else {
+            qWarning() << "UbuntuShape: can't load mipmap textures from" << file.fileName();
+        }
         for (int i = 0; i < shapeTextureCount; i++) {
             glBindTexture(GL_TEXTURE_2D, ids[i]);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -185,7 +194,8 @@ static void createShapeTextures(QOpenGLContext* openglContext, quint32* ids)
             for (int j = 0; j < shapeTextureMipmapCount; j++) {
                 glTexImage2D(GL_TEXTURE_2D, j, GL_RGBA, shapeTextureMipmapWidth >> j,
                              shapeTextureMipmapHeight >> j, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                             &shapeTextureMipmapData[i][shapeTextureMipmapOffset[j]]);
+                             mipmapData ? &mipmapData[i * shapeTextureMipmapSize
+                                                      + shapeTextureMipmapOffset[j]] : Q_NULLPTR);
             }
         }
     }
@@ -310,10 +320,11 @@ const QSGGeometry::AttributeSet& ShapeNode::attributeSet()
         QSGGeometry::Attribute::create(1, 2, GL_FLOAT),
         QSGGeometry::Attribute::create(2, 4, GL_FLOAT),
         QSGGeometry::Attribute::create(3, 1, GL_FLOAT),
-        QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE)
+        QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE),
+        QSGGeometry::Attribute::create(5, 4, GL_UNSIGNED_BYTE)
     };
     static const QSGGeometry::AttributeSet attributeSet = {
-        5, sizeof(Vertex), attributes
+        6, sizeof(Vertex), attributes
     };
     return attributeSet;
 }
@@ -364,6 +375,7 @@ UCUbuntuShape::UCUbuntuShape(QQuickItem* parent)
     , m_sourceScale(1.0f, 1.0f)
     , m_sourceTranslation(0.0f, 0.0f)
     , m_sourceTransform(1.0f, 1.0f, 0.0f, 0.0f)
+    , m_sourceCoordTransform(1.0f, 1.0f, 0.0f, 0.0f)
     , m_relativeRadius(0)
     , m_radius(Small)
     , m_aspect(DropShadow)
@@ -415,6 +427,7 @@ void UCUbuntuShape::setRadius(const QString& radius)
         Medium : ((radius == QStringLiteral("large")) ? Large : Small);
     if (m_radius != newRadius) {
         m_radius = newRadius;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT radiusChanged();
     }
@@ -466,6 +479,7 @@ void UCUbuntuShape::setRelativeRadius(qreal relativeRadius)
     const quint8 relativeRadiusPacked = qRound(qBound(0.0, relativeRadius, 0.75) * 100.0);
     if (m_relativeRadius != relativeRadiusPacked) {
         m_relativeRadius = relativeRadiusPacked;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT relativeRadiusChanged();
     }
@@ -566,6 +580,7 @@ void UCUbuntuShape::setSourceOpacity(qreal sourceOpacity)
     const quint8 sourceOpacityPacked = qBound(0.0, sourceOpacity, 1.0) * static_cast<qreal>(0xff);
     if (m_sourceOpacity != sourceOpacityPacked) {
         m_sourceOpacity = sourceOpacityPacked;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT sourceOpacityChanged();
     }
@@ -629,6 +644,7 @@ void UCUbuntuShape::setSourceHorizontalWrapMode(UCUbuntuShape::WrapMode sourceHo
 
     if (m_sourceHorizontalWrapMode != sourceHorizontalWrapMode) {
         m_sourceHorizontalWrapMode = sourceHorizontalWrapMode;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT sourceHorizontalWrapModeChanged();
     }
@@ -640,6 +656,7 @@ void UCUbuntuShape::setSourceVerticalWrapMode(UCUbuntuShape::WrapMode sourceVert
 
     if (m_sourceVerticalWrapMode != sourceVerticalWrapMode) {
         m_sourceVerticalWrapMode = sourceVerticalWrapMode;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT sourceVerticalWrapModeChanged();
     }
@@ -786,6 +803,7 @@ void UCUbuntuShape::setBackgroundColor(const QColor& backgroundColor)
         backgroundColor.alpha());
     if (m_backgroundColor != backgroundColorRgb) {
         m_backgroundColor = backgroundColorRgb;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT backgroundColorChanged();
     }
@@ -808,6 +826,7 @@ void UCUbuntuShape::setSecondaryBackgroundColor(const QColor& secondaryBackgroun
         secondaryBackgroundColor.blue(), secondaryBackgroundColor.alpha());
     if (m_secondaryBackgroundColor != secondaryBackgroundColorRgb) {
         m_secondaryBackgroundColor = secondaryBackgroundColorRgb;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT secondaryBackgroundColorChanged();
     }
@@ -833,6 +852,7 @@ void UCUbuntuShape::setBackgroundMode(BackgroundMode backgroundMode)
 
     if (m_backgroundMode != backgroundMode) {
         m_backgroundMode = backgroundMode;
+        m_flags |= DirtyGeometry;
         update();
         Q_EMIT backgroundModeChanged();
     }
@@ -896,6 +916,7 @@ void UCUbuntuShape::setColor(const QColor& color)
                 m_secondaryBackgroundColor = colorRgb;
                 Q_EMIT gradientColorChanged();
             }
+            m_flags |= DirtyGeometry;
             update();
             Q_EMIT colorChanged();
         }
@@ -923,6 +944,7 @@ void UCUbuntuShape::setGradientColor(const QColor& gradientColor)
             gradientColor.alpha());
         if (m_secondaryBackgroundColor != gradientColorRgb) {
             m_secondaryBackgroundColor = gradientColorRgb;
+            m_flags |= DirtyGeometry;
             update();
             Q_EMIT gradientColorChanged();
         }
@@ -1078,6 +1100,7 @@ void UCUbuntuShape::_q_gridUnitChanged()
     const float gridUnitInDevicePixels = UCUnits::instance()->gridUnit() / qGuiApp->devicePixelRatio();
     setImplicitWidth(implicitWidthGU * gridUnitInDevicePixels);
     setImplicitHeight(implicitHeightGU * gridUnitInDevicePixels);
+    m_flags |= DirtyGeometry;
     update();
 }
 
@@ -1111,7 +1134,7 @@ void UCUbuntuShape::componentComplete()
 void UCUbuntuShape::geometryChanged(const QRectF& newGeometry, const QRectF& oldGeometry)
 {
     QQuickItem::geometryChanged(newGeometry, oldGeometry);
-    m_flags |= DirtySourceTransform;
+    m_flags |= DirtySourceTransform | DirtyGeometry;
 }
 
 // Gets the nearest boundary to coord in the texel grid of the given size.
@@ -1181,6 +1204,23 @@ static quint32 averageColor(QRgb c1, QRgb c2)
         (qGreen(c1) + qGreen(c2)) >> 1, (qRed(c1) + qRed(c2)) >> 1);
 }
 
+// Pack the source opacity and the anti-aliasing distance factor. The factor is 1 most of the time
+// apart when the radius size is low, it linearly goes from 1 to 0 to make the corners prettier and
+// to prevent the opacity of the whole shape to slightly lower. Return value is a 32-bit integer
+// read as 4 normalized unsigned bytes by the shaders.
+static quint32 packParameters(quint8 sourceOpacity, float radius)
+{
+    const float physicalRadius = radius * qGuiApp->devicePixelRatio();
+
+    // Mapping of radius size range from [0, 4] to [0, 1] with clamping, plus quantization.
+    const float start = 0.0f + radiusSizeOffset;
+    const float end = 4.0f + radiusSizeOffset;
+    const float distanceAAFactor =
+        qBound(0.0f, (physicalRadius / (end - start)) - (start / (end - start)), 1.0f);
+
+    return (static_cast<quint32>(distanceAAFactor * 255.0f) << 8) | sourceOpacity;
+}
+
 QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data)
 {
     Q_UNUSED(data);
@@ -1191,8 +1231,16 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
         return NULL;
     }
 
-    QSGNode* node = oldNode ? oldNode : createSceneGraphNode();
-    Q_ASSERT(node);
+    QSGNode* node = oldNode;
+    if (!node) {
+        if (UCSoftwareShapeNode::isSoftwareRendering(window())) {
+            node = new UCSoftwareShapeNode(window());
+        } else {
+            node = createSceneGraphNode();
+        }
+        Q_ASSERT(node);
+        m_flags |= DirtyGeometry;
+    }
 
     // Get the source texture info and update the source transform if needed.
     QSGTextureProvider* provider = m_source ? m_source->textureProvider() : NULL;
@@ -1219,6 +1267,13 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
         }
     }
 
+    // The background colors and the source opacity stored in the vertices depend on whether
+    // there's a source texture.
+    if (!sourceTexture != !(m_flags & HasSourceTexture)) {
+        m_flags ^= HasSourceTexture;
+        m_flags |= DirtyGeometry;
+    }
+
     // Ensure the shape item is updated whenever the source item's texture changes.
     if (provider != m_sourceTextureProvider) {
         if (m_sourceTextureProvider) {
@@ -1252,7 +1307,15 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
                      / qGuiApp->devicePixelRatio();
     }
 
-    updateMaterial(node, radius, m_aspect != DropShadow ? 0 : 1, sourceTexture && m_sourceOpacity);
+    // The software adaptation doesn't support custom materials, the shape is painted instead.
+    if (node->type() == QSGNode::RenderNodeType) {
+        updateSoftwareNode(static_cast<UCSoftwareShapeNode*>(node), itemSize, radius, sourceTexture);
+        m_flags &= ~DirtyGeometry;
+        return node;
+    }
+
+    const bool textured = sourceTexture && m_sourceOpacity;
+    updateMaterial(node, radius, m_aspect != DropShadow ? 0 : 1, textured);
 
     // Get the affine transformation for the source texture coordinates.
     const QVector4D sourceCoordTransform(
@@ -1261,6 +1324,17 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
         m_sourceTransform.z() * sourceTextureRect.width() + sourceTextureRect.x(),
         m_sourceTransform.w() * sourceTextureRect.height() + sourceTextureRect.y());
 
+    // Texture updates of dynamic sources (layers, videos) and aspect changes only affect the
+    // material, the vertices are kept as is unless the source transform or the texture atlas
+    // area changed.
+    if (sourceCoordTransform != m_sourceCoordTransform) {
+        m_sourceCoordTransform = sourceCoordTransform;
+        m_flags |= DirtyGeometry;
+    }
+    if (!(m_flags & DirtyGeometry)) {
+        return node;
+    }
+
     // Get the affine transformation for the source mask coordinates, pixels lying inside the mask
     // (values in the range [-1, 1]) will be textured in the fragment shader. In case of a repeat
     // wrap mode, the transformation is made so that the mask takes the whole area.
@@ -1272,12 +1346,30 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
 
     // Select and pack the lerped and premultiplied background colors.
     QRgb color[2];
+    backgroundColors(color, sourceTexture);
+    const quint32 backgroundColor[3] = {
+        packColor(qAlpha(color[0]), qBlue(color[0]), qGreen(color[0]), qRed(color[0])),
+        averageColor(color[0], color[1]),
+        packColor(qAlpha(color[1]), qBlue(color[1]), qGreen(color[1]), qRed(color[1]))
+    };
+
+    updateGeometry(
+        node, itemSize, radius, shapeTextureOffset, sourceCoordTransform, sourceMaskTransform,
+        backgroundColor, packParameters(textured ? m_sourceOpacity : 0, radius));
+    m_flags &= ~DirtyGeometry;
+
+    return node;
+}
+
+// Selects the top and bottom background colors.
+void UCUbuntuShape::backgroundColors(QRgb color[2], bool hasSourceTexture) const
+{
     if (m_flags & BackgroundApiSet) {
         color[0] = m_backgroundColor;
         color[1] = (m_backgroundMode == SolidColor) ?
             m_backgroundColor : m_secondaryBackgroundColor;
     } else {
-        if (!sourceTexture) {
+        if (!hasSourceTexture) {
             color[0] = m_backgroundColor;
             // For API compatibility reasons, m_secondaryBackgroundColor is set to m_backgroundColor
             // as long as setGradientColor() isn't called, so we can safely use it here.
@@ -1289,17 +1381,106 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
             color[1] = qRgba(0, 0, 0, 0);
         }
     }
-    const quint32 backgroundColor[3] = {
-        packColor(qAlpha(color[0]), qBlue(color[0]), qGreen(color[0]), qRed(color[0])),
-        averageColor(color[0], color[1]),
-        packColor(qAlpha(color[1]), qBlue(color[1]), qGreen(color[1]), qRed(color[1]))
-    };
+}
 
-    updateGeometry(
-        node, itemSize, radius, shapeTextureOffset, sourceCoordTransform, sourceMaskTransform,
-        backgroundColor);
+void UCUbuntuShape::paintSoftwareContent(
+    QPainter* painter, const QSizeF& itemSize, QSGTexture* sourceTexture)
+{
+    const QRectF rect(QPointF(0.0, 0.0), itemSize);
+    QRgb color[2];
+    backgroundColors(color, sourceTexture);
+    if (color[0] == color[1]) {
+        if (qAlpha(color[0])) {
+            painter->fillRect(rect, QColor::fromRgba(color[0]));
+        }
+    } else {
+        QLinearGradient gradient(0.0, 0.0, 0.0, itemSize.height());
+        gradient.setColorAt(0.0, QColor::fromRgba(color[0]));
+        gradient.setColorAt(1.0, QColor::fromRgba(color[1]));
+        painter->fillRect(rect, gradient);
+    }
 
-    return node;
+    if (!sourceTexture || !m_sourceOpacity
+        || qFuzzyIsNull(m_sourceTransform.x()) || qFuzzyIsNull(m_sourceTransform.y())) {
+        return;
+    }
+    const QPixmap pixmap = UCSoftwareShapeNode::texturePixmap(sourceTexture);
+    if (pixmap.isNull()) {
+        return;
+    }
+
+    // Get the area covered by the texture, the source transform maps the item to the texture.
+    const QRectF textureRect(
+        -m_sourceTransform.z() / m_sourceTransform.x() * itemSize.width(),
+        -m_sourceTransform.w() / m_sourceTransform.y() * itemSize.height(),
+        itemSize.width() / m_sourceTransform.x(), itemSize.height() / m_sourceTransform.y());
+    QRectF fillRect = rect;
+    if (m_sourceHorizontalWrapMode == Transparent) {
+        fillRect.setLeft(qMax(rect.left(), textureRect.left()));
+        fillRect.setRight(qMin(rect.right(), textureRect.right()));
+    }
+    if (m_sourceVerticalWrapMode == Transparent) {
+        fillRect.setTop(qMax(rect.top(), textureRect.top()));
+        fillRect.setBottom(qMin(rect.bottom(), textureRect.bottom()));
+    }
+    if (fillRect.isEmpty()) {
+        return;
+    }
+
+    // A texture brush repeats the source outside of the texture area.
+    QTransform brushTransform = QTransform::fromTranslate(textureRect.x(), textureRect.y());
+    brushTransform.scale(textureRect.width() / pixmap.width(), textureRect.height() / pixmap.height());
+    QBrush brush(pixmap);
+    brush.setTransform(brushTransform);
+    painter->save();
+    painter->setOpacity(m_sourceOpacity / 255.0);
+    painter->fillRect(fillRect, brush);
+    painter->restore();
+}
+
+// Paints the shape with the software adaptation. Aspects are approximated: the inset aspect gets a
+// thin inner shadow and bevel, the drop shadow is a translucent copy of the shape one pixel below.
+void UCUbuntuShape::updateSoftwareNode(
+    UCSoftwareShapeNode* node, const QSizeF& itemSize, float radius, QSGTexture* sourceTexture)
+{
+    QImage* image = node->beginPaint(itemSize);
+    const qreal dpr = window()->effectiveDevicePixelRatio();
+    const int linePixels = qMax(1, qRound(dpr));
+    const bool hasAspect = radius * dpr > radiusSizeOffset;
+    const int shadowOffset = (hasAspect && m_aspect == DropShadow) ? linePixels : 0;
+    const QRect shapeRect(0, 0, image->width(), image->height() - shadowOffset);
+    const int radiusPixels = hasAspect ? qRound(radius * dpr) : 0;
+
+    QPainter painter(image);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.scale(dpr, dpr);
+    paintSoftwareContent(&painter, QSizeF(shapeRect.width() / dpr, shapeRect.height() / dpr),
+                         sourceTexture);
+    painter.resetTransform();
+
+    painter.setCompositionMode(QPainter::CompositionMode_SourceAtop);
+    if (hasAspect && (m_aspect == Inset || m_aspect == Pressed)) {
+        painter.fillRect(QRect(0, 0, shapeRect.width(), linePixels), QColor(0, 0, 0, 64));
+        painter.fillRect(QRect(0, shapeRect.height() - linePixels, shapeRect.width(), linePixels),
+                         QColor(255, 255, 255, 153));
+    }
+    if (m_aspect == Pressed) {
+        painter.fillRect(shapeRect, QColor(0, 0, 0, qRound((1.0f - pressedFactor) * 255.0f)));
+    }
+    UCSoftwareShapeNode::maskCorners(&painter, shapeRect, radiusPixels);
+
+    if (shadowOffset > 0) {
+        QImage shadow(shapeRect.size(), QImage::Format_ARGB32_Premultiplied);
+        shadow.fill(QColor(0, 0, 0, 64));
+        QPainter shadowPainter(&shadow);
+        UCSoftwareShapeNode::maskCorners(&shadowPainter, shadow.rect(), radiusPixels);
+        shadowPainter.end();
+        painter.setCompositionMode(QPainter::CompositionMode_DestinationOver);
+        painter.drawImage(0, shadowOffset, shadow);
+    }
+    painter.end();
+
+    node->endPaint();
 }
 
 QSGNode* UCUbuntuShape::createSceneGraphNode() const
@@ -1311,12 +1492,11 @@ void UCUbuntuShape::updateMaterial(
     QSGNode* node, float radius, quint8 shapeTextureIndex, bool textured)
 {
     ShapeMaterial::Data* materialData = static_cast<ShapeNode*>(node)->material()->data();
+    QSGTextureProvider* sourceTextureProvider = NULL;
     quint8 flags = 0;
 
-    materialData->shapeTextureIndex = shapeTextureIndex;
     if (textured) {
-        materialData->sourceTextureProvider = m_sourceTextureProvider;
-        materialData->sourceOpacity = m_sourceOpacity;
+        sourceTextureProvider = m_sourceTextureProvider;
         if (m_sourceHorizontalWrapMode == Repeat) {
             flags |= ShapeMaterial::Data::HorizontallyRepeated;
         }
@@ -1324,20 +1504,10 @@ void UCUbuntuShape::updateMaterial(
             flags |= ShapeMaterial::Data::VerticallyRepeated;
         }
         flags |= ShapeMaterial::Data::Textured;
-    } else {
-        materialData->sourceTextureProvider = NULL;
-        materialData->sourceOpacity = 0;
     }
 
     const float physicalRadius = radius * qGuiApp->devicePixelRatio();
 
-    // Mapping of radius size range from [0, 4] to [0, 1] with clamping, plus quantization.
-    const float start = 0.0f + radiusSizeOffset;
-    const float end = 4.0f + radiusSizeOffset;
-
-    materialData->distanceAAFactor =
-        qMin((physicalRadius / (end - start)) - (start / (end - start)), 1.0f) * 255.0f;
-
     // When the radius is equal to radiusSizeOffset (which means radius size is 0), no aspect is
     // flagged so that a dedicated (statically flow controlled) shaved off shader can be used for
     // optimal performance.
@@ -1352,13 +1522,20 @@ void UCUbuntuShape::updateMaterial(
         flags |= aspectFlags[m_aspect];
     }
 
-    materialData->flags = flags;
+    // The renderer must be told about material changes since the geometry isn't always dirty.
+    if (materialData->sourceTextureProvider != sourceTextureProvider
+        || materialData->shapeTextureIndex != shapeTextureIndex || materialData->flags != flags) {
+        materialData->sourceTextureProvider = sourceTextureProvider;
+        materialData->shapeTextureIndex = shapeTextureIndex;
+        materialData->flags = flags;
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
 }
 
 void UCUbuntuShape::updateGeometry(
     QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
     const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-    const quint32 backgroundColor[3])
+    const quint32 backgroundColor[3], quint32 parameters)
 {
     // Used by subclasses, using the shapeTextureOffset constant directly allows slightly
     // better optimization here.
@@ -1378,6 +1555,7 @@ void UCUbuntuShape::updateGeometry(
     v[0].sourceCoordinate[3] = sourceMaskTransform.w();
     v[0].yCoordinate = -1.0f;
     v[0].backgroundColor = backgroundColor[0];
+    v[0].parameters = parameters;
     v[1].position[0] = 0.5f * itemSize.width();
     v[1].position[1] = 0.0f;
     v[1].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeTextureOffset;
@@ -1388,6 +1566,7 @@ void UCUbuntuShape::updateGeometry(
     v[1].sourceCoordinate[3] = sourceMaskTransform.w();
     v[1].yCoordinate = -1.0f;
     v[1].backgroundColor = backgroundColor[0];
+    v[1].parameters = parameters;
     v[2].position[0] = itemSize.width();
     v[2].position[1] = 0.0f;
     v[2].shapeCoordinate[0] = shapeTextureOffset;
@@ -1398,6 +1577,7 @@ void UCUbuntuShape::updateGeometry(
     v[2].sourceCoordinate[3] = sourceMaskTransform.w();
     v[2].yCoordinate = -1.0f;
     v[2].backgroundColor = backgroundColor[0];
+    v[2].parameters = parameters;
 
     // Set middle row of 3 vertices.
     v[3].position[0] = 0.0f;
@@ -1410,6 +1590,7 @@ void UCUbuntuShape::updateGeometry(
     v[3].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[3].yCoordinate = 0.0f;
     v[3].backgroundColor = backgroundColor[1];
+    v[3].parameters = parameters;
     v[4].position[0] = 0.5f * itemSize.width();
     v[4].position[1] = 0.5f * itemSize.height();
     v[4].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeTextureOffset;
@@ -1420,6 +1601,7 @@ void UCUbuntuShape::updateGeometry(
     v[4].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[4].yCoordinate = 0.0f;
     v[4].backgroundColor = backgroundColor[1];
+    v[4].parameters = parameters;
     v[5].position[0] = itemSize.width();
     v[5].position[1] = 0.5f * itemSize.height();
     v[5].shapeCoordinate[0] = shapeTextureOffset;
@@ -1430,6 +1612,7 @@ void UCUbuntuShape::updateGeometry(
     v[5].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[5].yCoordinate = 0.0f;
     v[5].backgroundColor = backgroundColor[1];
+    v[5].parameters = parameters;
 
     // Set bottom row of 3 vertices.
     v[6].position[0] = 0.0f;
@@ -1442,6 +1625,7 @@ void UCUbuntuShape::updateGeometry(
     v[6].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[6].yCoordinate = 1.0f;
     v[6].backgroundColor = backgroundColor[2];
+    v[6].parameters = parameters;
     v[7].position[0] = 0.5f * itemSize.width();
     v[7].position[1] = itemSize.height();
     v[7].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeTextureOffset;
@@ -1452,6 +1636,7 @@ void UCUbuntuShape::updateGeometry(
     v[7].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[7].yCoordinate = 1.0f;
     v[7].backgroundColor = backgroundColor[2];
+    v[7].parameters = parameters;
     v[8].position[0] = itemSize.width();
     v[8].position[1] = itemSize.height();
     v[8].shapeCoordinate[0] = shapeTextureOffset;
@@ -1462,7 +1647,9 @@ void UCUbuntuShape::updateGeometry(
     v[8].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[8].yCoordinate = 1.0f;
     v[8].backgroundColor = backgroundColor[2];
+    v[8].parameters = parameters;
 
+    static_cast<ShapeNode*>(node)->geometry()->markVertexDataDirty();
     node->markDirty(QSGNode::DirtyGeometry);
 }
 
@@ -27,10 +27,15 @@
 #include <UbuntuToolkit/private/ucimportversionchecker_p.h>
 #include <UbuntuToolkit/private/ucubuntushapetextures_p.h>
 
+QT_FORWARD_DECLARE_CLASS(QPainter)
+QT_FORWARD_DECLARE_CLASS(QSGTexture)
+
 // --- Scene graph shader ---
 
 UT_NAMESPACE_BEGIN
 
+class UCSoftwareShapeNode;
+
 class ShapeShader : public QSGMaterialShader
 {
 public:
@@ -46,7 +51,6 @@ private:
     bool m_useDistanceFields;
     int m_matrixId;
     int m_opacityFactorsId;
-    int m_sourceOpacityId;
     int m_distanceAAId;
     int m_texturedId;
     int m_aspectId;
@@ -69,10 +73,10 @@ public:
             AspectMask           = (Flat | Inset | DropShadow),
             Pressed              = (1 << 6)
         };
+        // Parameters varying between shapes are passed as vertex data, so that shapes differing
+        // only by them share the same material state and can be batched.
         QSGTextureProvider* sourceTextureProvider;
         quint8 shapeTextureIndex;
-        quint8 distanceAAFactor;
-        quint8 sourceOpacity;
         quint8 flags;
     };
 
@@ -102,6 +106,7 @@ public:
         float sourceCoordinate[4];
         float yCoordinate;
         quint32 backgroundColor;
+        quint32 parameters;  // Source opacity and anti-aliasing distance factor.
     };
 
     static const int indexCount = 14;
@@ -109,7 +114,7 @@ public:
     static const int indexTypeSize = sizeof(unsigned short);
     static const int vertexCount = 9;
     static const QSGGeometry::DataPattern indexDataPattern = QSGGeometry::StaticPattern;
-    static const QSGGeometry::DataPattern vertexDataPattern = QSGGeometry::AlwaysUploadPattern;
+    static const QSGGeometry::DataPattern vertexDataPattern = QSGGeometry::DynamicPattern;
     static const GLenum drawingMode = GL_TRIANGLE_STRIP;
     static const unsigned short* indices();
     static const QSGGeometry::AttributeSet& attributeSet();
@@ -307,7 +312,14 @@ protected:
     virtual void updateGeometry(
         QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
         const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-        const quint32 backgroundColor[3]);
+        const quint32 backgroundColor[3], quint32 parameters);
+    // Requests a geometry update at next paint node update, extended shapes must call it whenever
+    // a property stored in their vertices changes.
+    void markGeometryDirty() { m_flags |= DirtyGeometry; }
+    // Paints the background and the source with the software adaptation, the corners and the
+    // aspect are applied afterwards.
+    virtual void paintSoftwareContent(
+        QPainter* painter, const QSizeF& itemSize, QSGTexture* sourceTexture);
 
 private Q_SLOTS:
     void _q_imagePropertiesChanged();
@@ -326,6 +338,9 @@ private:
     void updateSourceTransform(
         float itemWidth, float itemHeight, FillMode fillMode, HAlignment horizontalAlignment,
         VAlignment verticalAlignment, const QSize& textureSize);
+    void backgroundColors(QRgb color[2], bool hasSourceTexture) const;
+    void updateSoftwareNode(
+        UCSoftwareShapeNode* node, const QSizeF& itemSize, float radius, QSGTexture* sourceTexture);
 
     enum Radius { Small = 0, Medium = 1, Large = 2 };
     enum { Pressed = 3 };  // Aspect extension (to keep support for deprecated aspects).
@@ -335,7 +350,9 @@ private:
         BackgroundApiSet     = (1 << 2),
         SourceApiSet         = (1 << 3),
         Stretched            = (1 << 4),
-        DirtySourceTransform = (1 << 5)
+        DirtySourceTransform = (1 << 5),
+        DirtyGeometry        = (1 << 6),
+        HasSourceTexture     = (1 << 7)
     };
 
     QQuickItem* m_source;
@@ -345,6 +362,7 @@ private:
     QVector2D m_sourceScale;
     QVector2D m_sourceTranslation;
     QVector4D m_sourceTransform;
+    QVector4D m_sourceCoordTransform;
     quint8 m_relativeRadius;
     Radius m_radius : 2;
     quint8 m_aspect : 3;
@@ -22,6 +22,8 @@
 
 #include "ucubuntushapeoverlay_p.h"
 
+#include <QtGui/QPainter>
+
 // -- Scene graph shader ---
 
 UT_NAMESPACE_BEGIN
@@ -38,7 +40,7 @@ char const* const* ShapeOverlayShader::attributeNames() const
 {
     static char const* const attributes[] = {
         "positionAttrib", "shapeCoordAttrib", "sourceCoordAttrib", "yCoordAttrib",
-        "backgroundColorAttrib", "overlayCoordAttrib", "overlayColorAttrib", 0
+        "backgroundColorAttrib", "overlayCoordAttrib", "overlayColorAttrib", "parametersAttrib", 0
     };
     return attributes;
 }
@@ -87,10 +89,11 @@ const QSGGeometry::AttributeSet& ShapeOverlayNode::attributeSet()
         QSGGeometry::Attribute::create(3, 1, GL_FLOAT),
         QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE),
         QSGGeometry::Attribute::create(5, 2, GL_FLOAT),
-        QSGGeometry::Attribute::create(6, 4, GL_UNSIGNED_BYTE)
+        QSGGeometry::Attribute::create(6, 4, GL_UNSIGNED_BYTE),
+        QSGGeometry::Attribute::create(7, 4, GL_UNSIGNED_BYTE)
     };
     static const QSGGeometry::AttributeSet attributeSet = {
-        7, sizeof(Vertex), attributes
+        8, sizeof(Vertex), attributes
     };
     return attributeSet;
 }
@@ -185,6 +188,7 @@ void UCUbuntuShapeOverlay::setOverlayRect(const QRectF& overlayRect)
         m_overlayY = overlayY;
         m_overlayWidth = overlayWidth;
         m_overlayHeight = overlayHeight;
+        markGeometryDirty();
         update();
         Q_EMIT overlayRectChanged();
     }
@@ -202,6 +206,7 @@ void UCUbuntuShapeOverlay::setOverlayColor(const QColor& overlayColor)
         overlayColor.red(), overlayColor.green(), overlayColor.blue(), overlayColor.alpha());
     if (m_overlayColor != overlayColorRgb) {
         m_overlayColor = overlayColorRgb;
+        markGeometryDirty();
         update();
         Q_EMIT overlayColorChanged();
     }
@@ -212,6 +217,18 @@ QSGNode* UCUbuntuShapeOverlay::createSceneGraphNode() const
     return new ShapeOverlayNode;
 }
 
+void UCUbuntuShapeOverlay::paintSoftwareContent(
+    QPainter* painter, const QSizeF& itemSize, QSGTexture* sourceTexture)
+{
+    UCUbuntuShape::paintSoftwareContent(painter, itemSize, sourceTexture);
+    if (qAlpha(m_overlayColor)) {
+        const QRectF rect = overlayRect();
+        painter->fillRect(QRectF(rect.x() * itemSize.width(), rect.y() * itemSize.height(),
+                                 rect.width() * itemSize.width(), rect.height() * itemSize.height()),
+                          QColor::fromRgba(m_overlayColor));
+    }
+}
+
 // Pack to a premultiplied 32-bit ABGR integer.
 static quint32 packColor(QRgb color)
 {
@@ -225,7 +242,7 @@ static quint32 packColor(QRgb color)
 void UCUbuntuShapeOverlay::updateGeometry(
     QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
     const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-    const quint32 backgroundColor[3])
+    const quint32 backgroundColor[3], quint32 parameters)
 {
     ShapeOverlayNode::Vertex* v = reinterpret_cast<ShapeOverlayNode::Vertex*>(
         static_cast<ShapeOverlayNode*>(node)->geometry()->vertexData());
@@ -259,6 +276,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[0].overlayCoordinate[0] = overlayTx;
     v[0].overlayCoordinate[1] = overlayTy;
     v[0].overlayColor = overlayColor;
+    v[0].parameters = parameters;
     v[1].position[0] = 0.5f * itemSize.width();
     v[1].position[1] = 0.0f;
     v[1].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeOffset;
@@ -272,6 +290,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[1].overlayCoordinate[0] = 0.5f * overlaySx + overlayTx;
     v[1].overlayCoordinate[1] = overlayTy;
     v[1].overlayColor = overlayColor;
+    v[1].parameters = parameters;
     v[2].position[0] = itemSize.width();
     v[2].position[1] = 0.0f;
     v[2].shapeCoordinate[0] = shapeOffset;
@@ -285,6 +304,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[2].overlayCoordinate[0] = overlaySx + overlayTx;
     v[2].overlayCoordinate[1] = overlayTy;
     v[2].overlayColor = overlayColor;
+    v[2].parameters = parameters;
 
     // Set middle row of 3 vertices.
     v[3].position[0] = 0.0f;
@@ -300,6 +320,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[3].overlayCoordinate[0] = overlayTx;
     v[3].overlayCoordinate[1] = 0.5f * overlaySy + overlayTy;
     v[3].overlayColor = overlayColor;
+    v[3].parameters = parameters;
     v[4].position[0] = 0.5f * itemSize.width();
     v[4].position[1] = 0.5f * itemSize.height();
     v[4].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeOffset;
@@ -313,6 +334,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[4].overlayCoordinate[0] = 0.5f * overlaySx + overlayTx;
     v[4].overlayCoordinate[1] = 0.5f * overlaySy + overlayTy;
     v[4].overlayColor = overlayColor;
+    v[4].parameters = parameters;
     v[5].position[0] = itemSize.width();
     v[5].position[1] = 0.5f * itemSize.height();
     v[5].shapeCoordinate[0] = shapeOffset;
@@ -326,6 +348,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[5].overlayCoordinate[0] = overlaySx + overlayTx;
     v[5].overlayCoordinate[1] = 0.5f * overlaySy + overlayTy;
     v[5].overlayColor = overlayColor;
+    v[5].parameters = parameters;
 
     // Set bottom row of 3 vertices.
     v[6].position[0] = 0.0f;
@@ -341,6 +364,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[6].overlayCoordinate[0] = overlayTx;
     v[6].overlayCoordinate[1] = overlaySy + overlayTy;
     v[6].overlayColor = overlayColor;
+    v[6].parameters = parameters;
     v[7].position[0] = 0.5f * itemSize.width();
     v[7].position[1] = itemSize.height();
     v[7].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeOffset;
@@ -354,6 +378,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[7].overlayCoordinate[0] = 0.5f * overlaySx + overlayTx;
     v[7].overlayCoordinate[1] = overlaySy + overlayTy;
     v[7].overlayColor = overlayColor;
+    v[7].parameters = parameters;
     v[8].position[0] = itemSize.width();
     v[8].position[1] = itemSize.height();
     v[8].shapeCoordinate[0] = shapeOffset;
@@ -367,7 +392,9 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[8].overlayCoordinate[0] = overlaySx + overlayTx;
     v[8].overlayCoordinate[1] = overlaySy + overlayTy;
     v[8].overlayColor = overlayColor;
+    v[8].parameters = parameters;
 
+    static_cast<ShapeOverlayNode*>(node)->geometry()->markVertexDataDirty();
     node->markDirty(QSGNode::DirtyGeometry);
 }
 
@@ -54,6 +54,7 @@ public:
         quint32 backgroundColor;
         float overlayCoordinate[2];
         quint32 overlayColor;
+        quint32 parameters;
     };
 
     static const QSGGeometry::AttributeSet& attributeSet();
@@ -98,7 +99,9 @@ protected:
     void updateGeometry(
         QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
         const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-        const quint32 backgroundColor[3]) override;
+        const quint32 backgroundColor[3], quint32 parameters) override;
+    void paintSoftwareContent(
+        QPainter* painter, const QSizeF& itemSize, QSGTexture* sourceTexture) override;
 
 private:
     quint16 m_overlayX;
@@ -16,6 +16,10 @@ const int shapeTextureMipmapHeight = 256;
 const int shapeTextureMipmapCount = 9;
 
 extern const int shapeTextureMipmapOffset[9];
-extern const unsigned char shapeTextureMipmapData[2][349525];
+
+// The mipmap textures, rarely used, are stored one after the other in a compressed resource
+// instead of the library.
+const int shapeTextureMipmapSize = 349524;
+const char* const shapeTextureMipmapResource = ":/uc/shapetextures/shape_mipmap.raw";
 
 #endif // UCUBUNTUSHAPETEXTURES_H
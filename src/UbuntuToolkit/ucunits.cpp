@@ -20,6 +20,7 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
+#include <QtCore/QFileSystemWatcher>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QtMath>
 #include <QtGui/QGuiApplication>
@@ -168,6 +169,10 @@ void UCUnits::setGridUnit(float gridUnit)
         return;
     }
     m_gridUnit = gridUnit;
+    // the directory indexes stay valid, only the selected variants change
+    for (auto it = m_resourceDirectories.begin(); it != m_resourceDirectories.end(); ++it) {
+        it->resolved.clear();
+    }
     Q_EMIT gridUnitChanged();
 }
 
@@ -212,29 +217,58 @@ QString UCUnits::resolveResource(const QUrl& url)
         return QString();
     }
 
+    /* Resolution is done on an index of the directory holding the resource,
+       built on first access and dropped when the directory content changes.
+       The results are cached until the grid unit changes.
+    */
     const QFileInfo fileInfo(path);
-    if (fileInfo.exists()) {
-        if (fileInfo.isFile()) {
+    const QString directoryPath = fileInfo.absolutePath();
+    auto directory = m_resourceDirectories.find(directoryPath);
+    if (directory == m_resourceDirectories.end()) {
+        ResourceDirectory index;
+        indexResourceDirectory(directoryPath, &index);
+        if (!watchResourceDirectory(directoryPath)) {
+            // cannot tell when the index gets outdated, do not keep it
+            return resolveFromIndex(index, path, fileInfo);
+        }
+        directory = m_resourceDirectories.insert(directoryPath, index);
+    } else {
+        auto resolved = directory->resolved.constFind(path);
+        if (resolved != directory->resolved.constEnd()) {
+            return resolved.value();
+        }
+    }
+
+    const QString resolved = resolveFromIndex(*directory, path, fileInfo);
+    directory->resolved.insert(path, resolved);
+    return resolved;
+}
+
+QString UCUnits::resolveFromIndex(const ResourceDirectory &directory, const QString &path, const QFileInfo &fileInfo)
+{
+    auto entry = directory.entries.constFind(fileInfo.fileName());
+    if (entry != directory.entries.constEnd()) {
+        if (entry.value()) {
             return QStringLiteral("1/") + path;
         } else {
             return QString();
         }
     }
 
-    const QString prefix = fileInfo.dir().absolutePath() + "/" + fileInfo.baseName();
+    const QString prefix = fileInfo.absolutePath() + "/" + fileInfo.baseName();
     const QString suffix = "." + fileInfo.completeSuffix();
 
     /* Use file with expected grid unit suffix if it exists.
        For example, if m_gridUnit = 10, look for resource@10.png.
     */
 
-    path = prefix + suffixForGridUnit(m_gridUnit) + suffix;
-    if (QFile::exists(path)) {
-        return QStringLiteral("1/") + path;
+    const QString gridUnitSuffix = suffixForGridUnit(m_gridUnit);
+    if (directory.entries.contains(fileInfo.baseName() + gridUnitSuffix + suffix)) {
+        return QStringLiteral("1/") + prefix + gridUnitSuffix + suffix;
     }
 
     /* No file with expected grid unit suffix exists.
-       List all the files of the form fileBaseName@[0-9]*.fileSuffix and select
+       Take all the files of the form fileBaseName@[0-9]*.fileSuffix and select
        the most appropriate one privileging downscaling high resolution assets
        over upscaling low resolution assets.
 
@@ -249,29 +283,65 @@ QString UCUnits::resolveResource(const QUrl& url)
        file would be resource@14.png since it is above 10 and smaller
        than resource@18.png.
     */
-    QStringList nameFilters;
-    nameFilters << fileInfo.baseName() + "@[0-9]*" + suffix;
-    const QStringList files = fileInfo.dir().entryList(nameFilters, QDir::Files);
+    const QVector<float> gridUnits = directory.variants.value(qMakePair(fileInfo.baseName(), suffix));
 
-    if (!files.empty()) {
-        float selectedGridUnitSuffix = gridUnitSuffixFromFileName(files.first());
+    if (!gridUnits.isEmpty()) {
+        float selectedGridUnitSuffix = gridUnits.first();
 
-        Q_FOREACH (const QString& fileName, files) {
-            float gridUnitSuffix = gridUnitSuffixFromFileName(fileName);
+        for (float gridUnitSuffix : gridUnits) {
             if ((selectedGridUnitSuffix >= m_gridUnit && gridUnitSuffix >= m_gridUnit && gridUnitSuffix < selectedGridUnitSuffix)
                 || (selectedGridUnitSuffix < m_gridUnit && gridUnitSuffix > selectedGridUnitSuffix)) {
                 selectedGridUnitSuffix = gridUnitSuffix;
             }
         }
 
-        path = prefix + suffixForGridUnit(selectedGridUnitSuffix) + suffix;
         float scaleFactor = m_gridUnit / selectedGridUnitSuffix;
-        return QString::number(scaleFactor) + "/" + path;
+        return QString::number(scaleFactor) + "/" + prefix + suffixForGridUnit(selectedGridUnitSuffix) + suffix;
     }
 
     return QString();
 }
 
+void UCUnits::indexResourceDirectory(const QString &path, ResourceDirectory *directory)
+{
+    // base name, grid unit and suffix of fileBaseName@[0-9]*.fileSuffix
+    static const QRegularExpression variantName(QStringLiteral("^([^.]*)@([0-9]+)[^.]*(\\..*)$"));
+
+    const QFileInfoList entries = QDir(path).entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot);
+    Q_FOREACH (const QFileInfo &entry, entries) {
+        const QString fileName = entry.fileName();
+        directory->entries.insert(fileName, entry.isFile());
+        if (!entry.isFile()) {
+            continue;
+        }
+        QRegularExpressionMatch match = variantName.match(fileName);
+        if (match.hasMatch()) {
+            directory->variants[qMakePair(match.captured(1), match.captured(3))].append(match.captured(2).toFloat());
+        }
+    }
+}
+
+bool UCUnits::watchResourceDirectory(const QString &path)
+{
+    // resources do not change
+    if (path.startsWith(QLatin1Char(':'))) {
+        return true;
+    }
+    if (!m_resourceWatcher) {
+        m_resourceWatcher = new QFileSystemWatcher(this);
+        QObject::connect(m_resourceWatcher, &QFileSystemWatcher::directoryChanged,
+                         this, &UCUnits::resourceDirectoryChanged);
+    }
+    return QFileInfo(path).isDir() && m_resourceWatcher->addPath(path);
+}
+
+void UCUnits::resourceDirectoryChanged(const QString &path)
+{
+    m_resourceDirectories.remove(path);
+    // indexed and watched again on next access
+    m_resourceWatcher->removePath(path);
+}
+
 QString UCUnits::suffixForGridUnit(float gridUnit)
 {
     return "@" + QString::number(gridUnit);
@@ -279,7 +349,7 @@ QString UCUnits::suffixForGridUnit(float gridUnit)
 
 float UCUnits::gridUnitSuffixFromFileName(const QString& fileName)
 {
-    QRegularExpression re(QStringLiteral("^.*@([0-9]*).*$"));
+    static const QRegularExpression re(QStringLiteral("^.*@([0-9]*).*$"));
     QRegularExpressionMatch match = re.match(fileName);
     if (match.hasMatch()) {
         return match.captured(1).toFloat();
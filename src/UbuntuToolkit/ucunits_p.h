@@ -21,12 +21,16 @@
 
 #include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QPair>
 #include <QtCore/QString>
 #include <QtCore/QUrl>
+#include <QtCore/QVector>
 #include <QtGui/QWindow>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
+class QFileInfo;
+class QFileSystemWatcher;
 class QPlatformWindow;
 
 UT_NAMESPACE_BEGIN
@@ -72,12 +76,30 @@ private Q_SLOTS:
     void windowPropertyChanged(QPlatformWindow *window, const QString &propertyName);
     void screenChanged(QScreen *screen);
     void devicePixelRatioChanged(qreal dpi);
+    void resourceDirectoryChanged(const QString &path);
 
 private:
+    // index of the files in a directory containing resources
+    struct ResourceDirectory {
+        // file names, true for files, false for other entries
+        QHash<QString, bool> entries;
+        // grid unit suffixes available by base name and suffix, e.g. for "icon@18.png"
+        // the key is ("icon", ".png")
+        QHash<QPair<QString, QString>, QVector<float> > variants;
+        // resources resolved for the current grid unit, by path
+        QHash<QString, QString> resolved;
+    };
+
+    void indexResourceDirectory(const QString &path, ResourceDirectory *directory);
+    bool watchResourceDirectory(const QString &path);
+    QString resolveFromIndex(const ResourceDirectory &directory, const QString &path, const QFileInfo &fileInfo);
+
     static UCUnits *m_units;
     float m_devicePixelRatio;
     QScreen *m_screen;
     float m_gridUnit;
+    QHash<QString, ResourceDirectory> m_resourceDirectories;
+    QFileSystemWatcher *m_resourceWatcher = nullptr;
 };
 
 UT_NAMESPACE_END
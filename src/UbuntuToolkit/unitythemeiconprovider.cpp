@@ -18,16 +18,213 @@
 
 #include "unitythemeiconprovider_p.h"
 
+#include <QtCore/QCache>
 #include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
 #include <QtCore/QSettings>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QtDebug>
+#include <QtCore/QtEndian>
+#include <QtCore/QVector>
 #include <QtGui/QIcon>
 #include <QtGui/QImageReader>
 
+#include "uciconatlas_p.h"
+#include "ucimagediskcache_p.h"
+
 UT_NAMESPACE_BEGIN
 
+/*
+ * Index of the icons of an icon theme base directory. Uses the icon-theme.cache
+ * generated by gtk-update-icon-cache when it is up to date with the theme
+ * directories, or lists the theme directories otherwise. Indexes are shared by
+ * all the themes and never change once built.
+ */
+class IconIndex
+{
+public:
+    typedef QSharedPointer<IconIndex> IconIndexPointer;
+
+    // flags of icon-theme.cache images
+    enum Flags {
+        HasSvg = 0x2,
+        HasPng = 0x4
+    };
+
+    static IconIndexPointer get(const QString &baseDir, const QStringList &directories)
+    {
+        static QMutex mutex;
+        static QHash<QString, IconIndexPointer> indexes;
+
+        QMutexLocker lock(&mutex);
+        IconIndexPointer index = indexes.value(baseDir);
+        if (index.isNull()) {
+            index = IconIndexPointer(new IconIndex(baseDir, directories));
+            indexes.insert(baseDir, index);
+        }
+        return index;
+    }
+
+    // Returns the HasPng and HasSvg flags of @iconName in @directory.
+    int iconFlags(const QString &directory, const QString &iconName) const
+    {
+        if (m_cache) {
+            return cachedIconFlags(directory, iconName);
+        }
+        return m_icons.value(directory).value(iconName);
+    }
+
+private:
+    IconIndex(const QString &baseDir, const QStringList &directories)
+        : m_cacheFile(baseDir + QStringLiteral("/icon-theme.cache"))
+        , m_cache(Q_NULLPTR)
+        , m_cacheSize(0)
+    {
+        if (!mapCache(baseDir)) {
+            buildIndex(baseDir, directories);
+        }
+    }
+
+    bool mapCache(const QString &baseDir)
+    {
+        const QFileInfo info(m_cacheFile.fileName());
+        if (!info.exists() || info.lastModified() < QFileInfo(baseDir).lastModified()) {
+            return false;
+        }
+        if (!m_cacheFile.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        // the mapping lives as long as the file stays open
+        m_cacheSize = m_cacheFile.size();
+        m_cache = m_cacheSize >= 12 ? m_cacheFile.map(0, m_cacheSize) : Q_NULLPTR;
+        if (!m_cache) {
+            m_cacheFile.close();
+            return false;
+        }
+
+        // only version 1.0 is known; the cache is outdated if a directory changed after it
+        bool valid = read16(0) == 1 && read16(2) == 0;
+        const quint32 directoryList = read32(8);
+        const quint32 directoryCount = read32(directoryList);
+        for (quint32 i = 0; valid && i < directoryCount; i++) {
+            const QString directory = readString(read32(directoryList + 4 + 4 * i), &valid);
+            if (valid && info.lastModified() < QFileInfo(baseDir + "/" + directory).lastModified()) {
+                valid = false;
+            }
+            m_cacheDirectories.insert(directory, i);
+        }
+        if (!valid || !m_cacheValid) {
+            m_cacheFile.close();
+            m_cache = Q_NULLPTR;
+            m_cacheDirectories.clear();
+            return false;
+        }
+        return true;
+    }
+
+    void buildIndex(const QString &baseDir, const QStringList &directories)
+    {
+        const QStringList nameFilters = QStringList() << QStringLiteral("*.png") << QStringLiteral("*.svg");
+        Q_FOREACH(const QString &directory, directories) {
+            QHash<QString, int> &icons = m_icons[directory];
+            const QStringList files = QDir(baseDir + "/" + directory).entryList(nameFilters, QDir::Files | QDir::CaseSensitive);
+            Q_FOREACH(const QString &file, files) {
+                const int flag = file.endsWith(QLatin1String(".png")) ? HasPng : HasSvg;
+                icons[file.left(file.length() - 4)] |= flag;
+            }
+        }
+    }
+
+    // icon-theme.cache is big endian, with 4 byte aligned 32 bit values
+    quint16 read16(quint32 offset) const
+    {
+        if (offset > m_cacheSize - 2 || (offset & 0x1)) {
+            m_cacheValid = false;
+            return 0;
+        }
+        return qFromBigEndian<quint16>(m_cache + offset);
+    }
+
+    quint32 read32(quint32 offset) const
+    {
+        if (offset > m_cacheSize - 4 || (offset & 0x3)) {
+            m_cacheValid = false;
+            return 0;
+        }
+        return qFromBigEndian<quint32>(m_cache + offset);
+    }
+
+    QString readString(quint32 offset, bool *valid) const
+    {
+        const char *data = reinterpret_cast<const char*>(m_cache);
+        const int length = offset < m_cacheSize ? qstrnlen(data + offset, m_cacheSize - offset) : 0;
+        if (offset + length >= m_cacheSize) {
+            *valid = false;
+            return QString();
+        }
+        return QString::fromUtf8(data + offset, length);
+    }
+
+    // the hash gtk-update-icon-cache uses for icon names
+    static quint32 iconNameHash(const QByteArray &name)
+    {
+        const signed char *p = reinterpret_cast<const signed char*>(name.constData());
+        quint32 h = *p;
+        if (h) {
+            for (p += 1; *p != '\0'; p++) {
+                h = (h << 5) - h + *p;
+            }
+        }
+        return h;
+    }
+
+    int cachedIconFlags(const QString &directory, const QString &iconName) const
+    {
+        const auto directoryIndex = m_cacheDirectories.constFind(directory);
+        if (directoryIndex == m_cacheDirectories.constEnd()) {
+            return 0;
+        }
+
+        const QByteArray name = iconName.toUtf8();
+        const quint32 hashOffset = read32(4);
+        const quint32 bucketCount = read32(hashOffset);
+        if (!bucketCount) {
+            return 0;
+        }
+        quint32 icon = read32(hashOffset + 4 + 4 * (iconNameHash(name) % bucketCount));
+        while (icon != 0xffffffff && icon < m_cacheSize && m_cacheValid) {
+            const quint32 nameOffset = read32(icon + 4);
+            if (nameOffset < m_cacheSize && m_cacheSize - nameOffset > quint32(name.size())
+                    && !memcmp(m_cache + nameOffset, name.constData(), name.size() + 1)) {
+                const quint32 imageList = read32(icon + 8);
+                const quint32 imageCount = read32(imageList);
+                for (quint32 i = 0; i < imageCount && m_cacheValid; i++) {
+                    if (read16(imageList + 4 + 8 * i) == directoryIndex.value()) {
+                        return read16(imageList + 4 + 8 * i + 2) & (HasPng | HasSvg);
+                    }
+                }
+                return 0;
+            }
+            icon = read32(icon);
+        }
+        return 0;
+    }
+
+    QFile m_cacheFile;
+    uchar *m_cache;
+    quint32 m_cacheSize;
+    mutable bool m_cacheValid = true;
+    // directory index in the cache by directory name
+    QHash<QString, quint32> m_cacheDirectories;
+    // icon flags by directory and icon name, when there is no usable cache
+    QHash<QString, QHash<QString, int> > m_icons;
+};
+
 class IconTheme
 {
 public:
@@ -36,8 +233,11 @@ public:
     // Returns the icon theme named @name, creating it if it didn't exist yet.
     static IconThemePointer get(const QString &name)
     {
+        // recursive as creating a theme gets its parents
+        static QMutex mutex(QMutex::Recursive);
         static QHash<QString, IconThemePointer> themes;
 
+        QMutexLocker lock(&mutex);
         IconThemePointer theme = themes[name];
         if (theme.isNull()) {
             theme = IconThemePointer(new IconTheme(name));
@@ -49,28 +249,71 @@ public:
 
     // Does a breadth-first search for an icon with any name in @names. Parent
     // themes are only looked at if the current theme doesn't contain any icon
-    // in @names.
-    QImage findBestIcon(const QStringList &names, QSize *impsize, const QSize &size, QSet<QString> *alreadySearchedThemes)
+    // in @names. Returns the icon file and the size to load it at.
+    QString findBestIconFile(const QStringList &names, const QSize &size, QSize *loadSize, QSet<QString> *alreadySearchedThemes)
     {
         if (alreadySearchedThemes) {
             if (alreadySearchedThemes->contains(name))
-                return QImage();
+                return QString();
             alreadySearchedThemes->insert(name);
         }
 
         Q_FOREACH(const QString &name, names) {
-            QImage image = lookupIcon(name, impsize, size);
-            if (!image.isNull())
-                return image;
+            QString filename = lookupIcon(name, size, loadSize);
+            if (!filename.isNull())
+                return filename;
         }
 
         Q_FOREACH(IconThemePointer theme, parents) {
-            QImage image = theme->findBestIcon(names, impsize, size, alreadySearchedThemes);
-            if (!image.isNull())
-                return image;
+            QString filename = theme->findBestIconFile(names, size, loadSize, alreadySearchedThemes);
+            if (!filename.isNull())
+                return filename;
         }
 
-        return QImage();
+        return QString();
+    }
+
+    // Returns the size loadIcon() gives to an icon of @sourceSize.
+    static QSize scaledIconSize(const QSize &sourceSize, const QSize &requestSize, bool scalable)
+    {
+        QSize s = sourceSize;
+        if (requestSize.width() > 0 || requestSize.height() > 0) {
+            qreal ratio = 0.0;
+
+            if (requestSize.width() > 0 && (scalable || requestSize.width() < s.width())) {
+                ratio = qreal(requestSize.width())/s.width();
+            }
+            if (requestSize.height() > 0 && (scalable || requestSize.height() < s.height())) {
+                qreal hr = qreal(requestSize.height())/s.height();
+                if (ratio == 0.0 || hr < ratio)
+                    ratio = hr;
+            }
+            if (ratio > 0.0) {
+                s.setHeight(qRound(s.height() * ratio));
+                s.setWidth(qRound(s.width() * ratio));
+            }
+        }
+        return s;
+    }
+
+    static QImage loadIcon(const QString &filename, const QSize &requestSize)
+    {
+        QImageReader imgio(filename);
+
+        if (requestSize.width() > 0 || requestSize.height() > 0) {
+            const bool force_scale = (imgio.format() == "svg") || (imgio.format() == "svgz");
+            const QSize s = imgio.size();
+            const QSize scaled = scaledIconSize(s, requestSize, force_scale);
+            if (scaled != s)
+                imgio.setScaledSize(scaled);
+        }
+
+        QImage image;
+        if (imgio.read(&image)) {
+            return image;
+        } else {
+            return QImage();
+        }
     }
 
 private:
@@ -123,6 +366,14 @@ private:
                 break;
             }
         }
+
+        QStringList directoryPaths;
+        Q_FOREACH(const Directory &dir, directories) {
+            directoryPaths.append(dir.path);
+        }
+        Q_FOREACH(const QString &baseDir, baseDirs) {
+            indexes.append(IconIndex::get(baseDir, directoryPaths));
+        }
     }
 
     SizeType sizeTypeFromString(const QString &string)
@@ -137,81 +388,64 @@ private:
         return Fixed;
     }
 
-    static QImage loadIcon(const QString &filename, QSize *impsize, const QSize &requestSize)
+    QString lookupIconFile(const QString &dir, const QString &name)
     {
-        QImageReader imgio(filename);
-
-        if (requestSize.width() > 0 || requestSize.height() > 0) {
-            const bool force_scale = (imgio.format() == "svg") || (imgio.format() == "svgz");
-            QSize s = imgio.size();
-            qreal ratio = 0.0;
-
-            if (requestSize.width() > 0 && (force_scale || requestSize.width() < s.width())) {
-                ratio = qreal(requestSize.width())/s.width();
-            }
-            if (requestSize.height() > 0 && (force_scale || requestSize.height() < s.height())) {
-                qreal hr = qreal(requestSize.height())/s.height();
-                if (ratio == 0.0 || hr < ratio)
-                    ratio = hr;
-            }
-            if (ratio > 0.0) {
-                s.setHeight(qRound(s.height() * ratio));
-                s.setWidth(qRound(s.width() * ratio));
-                imgio.setScaledSize(s);
-            }
+        for (int i = 0; i < baseDirs.size(); i++) {
+            const int flags = indexes.at(i)->iconFlags(dir, name);
+            if (flags & IconIndex::HasPng)
+                return QStringLiteral("%1/%2/%3.png").arg(baseDirs.at(i), dir, name);
+            if (flags & IconIndex::HasSvg)
+                return QStringLiteral("%1/%2/%3.svg").arg(baseDirs.at(i), dir, name);
         }
 
-        if (impsize)
-            *impsize = imgio.scaledSize();
-
-        QImage image;
-        if (imgio.read(&image)) {
-            if (impsize)
-                *impsize = image.size();
-            return image;
-        } else {
-            return QImage();
-        }
+        return QString();
     }
 
-    QString lookupIconFile(const QString &dir, const QString &name)
+    // Returns the file of @name for each theme directory, or an empty list if
+    // the theme has no such icon. Results are cached, misses included.
+    QVector<QString> lookupIconFiles(const QString &name)
     {
-        QString png = QStringLiteral("%1/%2.png").arg(dir, name);
-        QString svg = QStringLiteral("%1/%2.svg").arg(dir, name);
-
-        Q_FOREACH(const QString &baseDir, baseDirs) {
-            QString filename = baseDir + "/" + png;
-            if (QFileInfo::exists(filename))
-                return filename;
-
-            filename = baseDir + "/" + svg;
-            if (QFileInfo::exists(filename))
-                return filename;
+        QMutexLocker lock(&iconFilesMutex);
+        auto cached = iconFiles.constFind(name);
+        if (cached != iconFiles.constEnd())
+            return cached.value();
+
+        QVector<QString> files(directories.size());
+        bool found = false;
+        for (int i = 0; i < directories.size(); i++) {
+            files[i] = lookupIconFile(directories.at(i).path, name);
+            found |= !files.at(i).isNull();
         }
-
-        return QString();
+        if (!found)
+            files.clear();
+        iconFiles.insert(name, files);
+        return files;
     }
 
-    QImage lookupIcon(const QString &iconName, QSize *impsize, const QSize &size)
+    QString lookupIcon(const QString &iconName, const QSize &size, QSize *loadSize)
     {
         const int iconSize = qMax(size.width(), size.height());
         if (iconSize > 0)
-            return lookupBestMatchingIcon(iconName, impsize, size);
+            return lookupBestMatchingIcon(iconName, size, loadSize);
         else
-            return lookupLargestIcon(iconName, impsize);
+            return lookupLargestIcon(iconName, loadSize);
     }
 
-    QImage lookupBestMatchingIcon(const QString &iconName, QSize *impsize, const QSize &size)
+    QString lookupBestMatchingIcon(const QString &iconName, const QSize &size, QSize *loadSize)
     {
+        const QVector<QString> files = lookupIconFiles(iconName);
+        if (files.isEmpty())
+            return QString();
+
         int minDistance = 10000;
         QString bestFilename;
 
-        Q_FOREACH(const Directory &dir, directories) {
-            int dist = directorySizeDistance(dir, size);
+        for (int i = 0; i < directories.size(); i++) {
+            int dist = directorySizeDistance(directories.at(i), size);
             if (dist >= minDistance)
                 continue;
 
-            QString filename = lookupIconFile(dir.path, iconName);
+            const QString &filename = files.at(i);
             if (!filename.isNull()) {
                 minDistance = dist;
                 bestFilename = filename;
@@ -222,33 +456,34 @@ private:
             }
         }
 
-        if (!bestFilename.isNull())
-            return loadIcon(bestFilename, impsize, size);
-
-        return QImage();
+        *loadSize = size;
+        return bestFilename;
     }
 
-    QImage lookupLargestIcon(const QString &iconName, QSize *impsize)
+    QString lookupLargestIcon(const QString &iconName, QSize *loadSize)
     {
+        const QVector<QString> files = lookupIconFiles(iconName);
+        if (files.isEmpty())
+            return QString();
+
         int maxSize = 0;
         QString bestFilename;
 
-        Q_FOREACH(const Directory &dir, directories) {
+        for (int i = 0; i < directories.size(); i++) {
+            const Directory &dir = directories.at(i);
             int size = dir.sizeType == Scalable ? dir.maxSize : dir.size;
             if (size < maxSize)
                 continue;
 
-            QString filename = lookupIconFile(dir.path, iconName);
+            const QString &filename = files.at(i);
             if (!filename.isNull()) {
                 maxSize = size;
                 bestFilename = filename;
             }
         }
 
-        if (!bestFilename.isNull())
-            return loadIcon(bestFilename, impsize, QSize(maxSize, maxSize));
-
-        return QImage();
+        *loadSize = QSize(maxSize, maxSize);
+        return bestFilename;
     }
 
     int directorySizeDistance(const Directory &dir, const QSize &iconSize)
@@ -271,12 +506,252 @@ private:
 
     QString name;
     QStringList baseDirs;
+    QList<IconIndex::IconIndexPointer> indexes; // one per base directory
     QList<Directory> directories;
     QList<IconThemePointer> parents;
+    QMutex iconFilesMutex;
+    QHash<QString, QVector<QString> > iconFiles;
+};
+
+/*
+ * Rasterized icons of all the providers. An icon is rasterized at the smallest
+ * size bucket holding the size it is requested at, and downscaled from there,
+ * so the many sizes icons are shown at share a few rasterizations. The least
+ * recently used rasterizations are dropped first.
+ */
+class ThemeIconCache
+{
+public:
+    ThemeIconCache()
+        : rasters(16 * 1024 * 1024) // bytes
+    {
+    }
+
+    QImage icon(const QString &filename, const QSize &loadSize, QSize *size);
+
+private:
+    struct Source {
+        QSize size;
+        bool scalable;
+    };
+
+    // the size to rasterize an icon of @iconSize at
+    static QSize rasterSize(const QSize &iconSize)
+    {
+        static const int buckets[] = { 16, 24, 32, 48, 64, 96, 128, 192, 256 };
+        const int extent = qMax(iconSize.width(), iconSize.height());
+        for (int bucket : buckets) {
+            if (extent <= bucket)
+                return QSize(bucket, bucket);
+        }
+        // large icons are rare, rasterize them at their size
+        return iconSize;
+    }
+
+    static QString rasterKey(const QString &filename, const QSize &iconSize)
+    {
+        const QSize size = rasterSize(iconSize);
+        return QStringLiteral("%1|%2x%3").arg(filename).arg(size.width()).arg(size.height());
+    }
+
+    QMutex mutex;
+    QHash<QString, Source> sources;
+    QCache<QString, QImage> rasters;
+};
+Q_GLOBAL_STATIC(ThemeIconCache, themeIconCache)
+
+// thread safe, rasterizations happen outside of the lock
+QImage ThemeIconCache::icon(const QString &filename, const QSize &loadSize, QSize *size)
+{
+    QMutexLocker lock(&mutex);
+    bool knownSource = false;
+    Source source;
+    QSize iconSize;
+    QString key;
+    QImage image;
+    auto cachedSource = sources.constFind(filename);
+    if (cachedSource != sources.constEnd()) {
+        knownSource = true;
+        source = cachedSource.value();
+        iconSize = IconTheme::scaledIconSize(source.size, loadSize, source.scalable);
+        key = rasterKey(filename, iconSize);
+        QImage *raster = rasters.object(key);
+        if (raster) {
+            image = *raster;
+        }
+    }
+    lock.unlock();
+
+    UCImageDiskCache *diskCache = UCImageDiskCache::instance();
+    QString diskKey;
+    if (image.isNull()) {
+        // icons rasterized by an earlier run skip parsing the source
+        diskKey = diskCache
+                ? UCImageDiskCache::key(filename, QStringLiteral("icon|%1x%2").arg(loadSize.width()).arg(loadSize.height()))
+                : QString();
+        if (!diskKey.isEmpty()) {
+            QImage cached = diskCache->load(diskKey);
+            if (!cached.isNull()) {
+                if (size)
+                    *size = cached.size();
+                return cached;
+            }
+        }
+
+        if (!knownSource) {
+            QImageReader reader(filename);
+            source.size = reader.size();
+            source.scalable = (reader.format() == "svg") || (reader.format() == "svgz");
+            iconSize = IconTheme::scaledIconSize(source.size, loadSize, source.scalable);
+            key = rasterKey(filename, iconSize);
+        }
+        image = IconTheme::loadIcon(filename, rasterSize(iconSize));
+        lock.relock();
+        sources.insert(filename, source);
+        rasters.insert(key, new QImage(image), qMax(1, image.bytesPerLine() * image.height()));
+        lock.unlock();
+    }
+
+    if (!image.isNull() && image.size() != iconSize) {
+        image = image.scaled(iconSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    if (!diskKey.isEmpty()) {
+        diskCache->store(diskKey, image, image.size());
+    }
+    if (size)
+        *size = image.size();
+    return image;
+}
+
+/*
+ * Loads an icon in the icon thread pool and hands it over to the response if
+ * that is still waiting for it.
+ */
+class ThemeIconJob : public QRunnable
+{
+public:
+    ThemeIconJob(ThemeIconResponse *response, const QString &themeName, const QString &id, const QSize &requestedSize)
+        : response(response), themeName(themeName), id(id), requestedSize(requestedSize)
+    {
+    }
+
+    void run() override;
+
+    ThemeIconResponse *response; // guarded by the queue mutex
+    QString themeName;
+    QString id;
+    QSize requestedSize;
 };
 
+/*
+ * The icon loading jobs of all providers, in a pool of their own so they do
+ * not compete with the other QThreadPool users.
+ */
+class ThemeIconQueue
+{
+public:
+    ThemeIconQueue()
+    {
+        // leave a core for the GUI and render threads
+        pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+    }
+    ~ThemeIconQueue()
+    {
+        pool.clear();
+        pool.waitForDone();
+    }
+
+    void request(ThemeIconResponse *response, const QString &themeName, const QString &id, const QSize &requestedSize);
+    void detach(ThemeIconResponse *response);
+    void finishJob(ThemeIconJob *job, const QImage &image, const QString &error);
+
+private:
+    QThreadPool pool;
+    QMutex mutex;
+};
+Q_GLOBAL_STATIC(ThemeIconQueue, themeIconQueue)
+
+void ThemeIconQueue::request(ThemeIconResponse *response, const QString &themeName, const QString &id, const QSize &requestedSize)
+{
+    QMutexLocker lock(&mutex);
+    ThemeIconJob *job = new ThemeIconJob(response, themeName, id, requestedSize);
+    response->m_job = job;
+    pool.start(job);
+}
+
+void ThemeIconQueue::detach(ThemeIconResponse *response)
+{
+    QMutexLocker lock(&mutex);
+    ThemeIconJob *job = response->m_job;
+    if (!job) {
+        return;
+    }
+    response->m_job = Q_NULLPTR;
+    job->response = Q_NULLPTR;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+    // drop the loading if it did not start yet
+    if (pool.tryTake(job)) {
+        delete job;
+    }
+#endif
+}
+
+void ThemeIconQueue::finishJob(ThemeIconJob *job, const QImage &image, const QString &error)
+{
+    QMutexLocker lock(&mutex);
+    if (!job->response) {
+        return;
+    }
+    job->response->m_job = Q_NULLPTR;
+    // responses live in the pixmap reader thread
+    QMetaObject::invokeMethod(job->response, "setImage", Qt::QueuedConnection,
+                              Q_ARG(QImage, image), Q_ARG(QString, error));
+}
+
+void ThemeIconJob::run()
+{
+    QSize size;
+    QImage image = UnityThemeIconProvider::loadIcon(themeName, id, &size, requestedSize);
+    themeIconQueue()->finishJob(this, image, image.isNull() ? QStringLiteral("Cannot find icon %1").arg(id) : QString());
+}
+
+ThemeIconResponse::ThemeIconResponse()
+    : m_job(Q_NULLPTR)
+{
+}
+
+ThemeIconResponse::~ThemeIconResponse()
+{
+    if (!themeIconQueue.isDestroyed()) {
+        themeIconQueue()->detach(this);
+    }
+}
+
+// small icons go to the icon atlas, so the scene graph can batch them
+QQuickTextureFactory *ThemeIconResponse::textureFactory() const
+{
+    return m_image.isNull() ? Q_NULLPTR : new UCIconTextureFactory(m_image);
+}
+
+QString ThemeIconResponse::errorString() const
+{
+    return m_error;
+}
+
+void ThemeIconResponse::cancel()
+{
+    themeIconQueue()->detach(this);
+}
+
+void ThemeIconResponse::setImage(const QImage &image, const QString &error)
+{
+    m_image = image;
+    m_error = error;
+    Q_EMIT finished();
+}
+
 UnityThemeIconProvider::UnityThemeIconProvider(const QString &themeName):
-    QQuickImageProvider(QQuickImageProvider::Image),
+    QQuickAsyncImageProvider(),
     m_themeName(themeName)
 {
     if (m_themeName.isEmpty())
@@ -284,30 +759,48 @@ UnityThemeIconProvider::UnityThemeIconProvider(const QString &themeName):
         m_themeName = QString::fromLocal8Bit(qgetenv("UITK_ICON_THEME"));
 }
 
-QSharedPointer<class IconTheme> UnityThemeIconProvider::getTheme()
+QString UnityThemeIconProvider::themeName() const
 {
     if (!m_themeName.isEmpty())
-        return IconTheme::get(m_themeName);
+        return m_themeName;
     else if (!QIcon::themeName().isEmpty())
-        return IconTheme::get(QIcon::themeName());
+        return QIcon::themeName();
     else
-        return IconTheme::get(QStringLiteral("suru"));
+        return QStringLiteral("suru");
+}
+
+// Icons are loaded in a thread pool of the provider, off the GUI thread,
+// whether or not the Image loads asynchronously.
+QQuickImageResponse *UnityThemeIconProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    ThemeIconResponse *response = new ThemeIconResponse;
+    themeIconQueue()->request(response, themeName(), id, requestedSize);
+    return response;
 }
 
 QImage UnityThemeIconProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    return loadIcon(themeName(), id, size, requestedSize);
+}
+
+// thread safe, used by the synchronous and the threaded loading
+QImage UnityThemeIconProvider::loadIcon(const QString &themeName, const QString &id, QSize *size, const QSize &requestedSize)
 {
     // The hicolor theme will be searched last as per
     // https://specifications.freedesktop.org/icon-theme-spec/icon-theme-spec-latest.html
     QSet<QString> alreadySearchedThemes;
     const QStringList names = id.split(QLatin1Char(','), QString::SkipEmptyParts);
-    QImage image = getTheme()->findBestIcon(names, size, requestedSize, &alreadySearchedThemes);
+    QSize loadSize;
+    QString filename = IconTheme::get(themeName)->findBestIconFile(names, requestedSize, &loadSize, &alreadySearchedThemes);
 
-    if (image.isNull()) {
+    if (filename.isNull()) {
         IconTheme::IconThemePointer theme = IconTheme::get(QStringLiteral("hicolor"));
-        return theme->findBestIcon(names, size, requestedSize, nullptr);
+        filename = theme->findBestIconFile(names, requestedSize, &loadSize, nullptr);
     }
+    if (filename.isNull())
+        return QImage();
 
-    return image;
+    return themeIconCache()->icon(filename, loadSize, size);
 }
 
 UT_NAMESPACE_END
@@ -19,21 +19,48 @@
 #ifndef UNITYTHEMEICONPROVIDER_P_H
 #define UNITYTHEMEICONPROVIDER_P_H
 
+#include <QtGui/QImage>
 #include <QtQuick/QQuickImageProvider>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
 UT_NAMESPACE_BEGIN
 
-class UBUNTUTOOLKIT_EXPORT UnityThemeIconProvider: public QQuickImageProvider
+class ThemeIconJob;
+class UBUNTUTOOLKIT_EXPORT ThemeIconResponse : public QQuickImageResponse
+{
+    Q_OBJECT
+public:
+    explicit ThemeIconResponse();
+    ~ThemeIconResponse();
+
+    QQuickTextureFactory *textureFactory() const override;
+    QString errorString() const override;
+    void cancel() override;
+
+private Q_SLOTS:
+    void setImage(const QImage &image, const QString &error);
+
+private:
+    ThemeIconJob *m_job;
+    QImage m_image;
+    QString m_error;
+
+    friend class ThemeIconQueue;
+};
+
+class UBUNTUTOOLKIT_EXPORT UnityThemeIconProvider: public QQuickAsyncImageProvider
 {
 public:
     UnityThemeIconProvider(const QString &themeName = QString());
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
     QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
 
+    static QImage loadIcon(const QString &themeName, const QString &id, QSize *size, const QSize &requestedSize);
+
 private:
     QString m_themeName;
-    QSharedPointer<class IconTheme> getTheme();
+    QString themeName() const;
 };
 
 UT_NAMESPACE_END
@@ -139,6 +139,8 @@ Item {
 
         // Whether or not a color has been set.
         visible: image.status == Image.Ready && keyColorOut != Qt.rgba(0.0, 0.0, 0.0, 0.0)
+        // Theme icons live in the icon atlas, sample them from there.
+        supportsAtlasTextures: true
 
         property Image source: image
         property color keyColorOut: Qt.rgba(0.0, 0.0, 0.0, 0.0)
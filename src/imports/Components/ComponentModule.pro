@@ -133,4 +133,5 @@ OTHER_FILES+= qmldir \
              1.3/MainView.qdoc \
              1.3/Icon.qdoc
 
+load(ubuntu_qml_cache)
 load(ubuntu_qml_plugin)
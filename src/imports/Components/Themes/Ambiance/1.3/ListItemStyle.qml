@@ -149,7 +149,8 @@ Styles.ListItemStyle {
                 anchors.centerIn: parent
                 // for the initial value
                 checked: styledItem.selected
-                onCheckedChanged: styledItem.selected = checked;
+                // only user toggles differ, bindings re-evaluated on style reuse do not
+                onCheckedChanged: if (checked != styledItem.selected) styledItem.selected = checked;
                 Binding {
                     target: checkbox
                     property: "checked"
@@ -382,7 +383,7 @@ Styles.ListItemStyle {
         velocity: units.gu(60)
         onStopped: {
             // trigger action
-            if (to == styledItem.contentItem.anchors.leftMargin && internals.selectedAction) {
+            if (internals.selectedAction && to == styledItem.contentItem.anchors.leftMargin) {
                 internals.selectedAction.trigger(listItemIndex);
                 internals.selectedAction = null;
             }
@@ -424,6 +425,17 @@ Styles.ListItemStyle {
     function rebound() {
         snapAnimation.snapTo(0);
     }
+    // kept for reuse, called when detached from the destroyed ListItem and when
+    // attached to the new one
+    function reset() {
+        internals.selectedAction = null;
+        internals.prevX = 0.0;
+        internals.snapChangerLimit = 0.0;
+        internals.snapIn = false;
+        // drop the panels of the previous ListItem, load the ones of the new one
+        leadingLoader.active = styledItem !== null;
+        trailingLoader.active = styledItem !== null;
+    }
 
     // expansion
     Component.onCompleted: internals.completed = true
@@ -124,6 +124,8 @@ QML_FILES += 1.2/ActivityIndicatorStyle.qml \
 	     1.3/SectionsForPageHeadStyle.qml \
              $$ARTWORK_FILES
 
+load(ubuntu_theme_manifest)
+load(ubuntu_qml_cache)
 load(ubuntu_qml_module)
 
 OTHER_FILES+=qmldir
@@ -16,4 +16,6 @@ QML_FILES += 1.2/MainViewStyle.qml \
              $$ARTWORK_FILES \
              $$PARENT_THEME_FILE
 
+load(ubuntu_theme_manifest)
+load(ubuntu_qml_cache)
 load(ubuntu_qml_module)
@@ -14,4 +14,5 @@ QML_FILES += MainViewStyle.qml \
     $$PARENT_THEME_FILE \
     $$DEPRECATED_FILE
 
+load(ubuntu_theme_manifest)
 load(ubuntu_qml_module)
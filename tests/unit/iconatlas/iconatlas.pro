@@ -0,0 +1,2 @@
+include(../test-include-x11.pri)
+SOURCES += tst_iconatlas.cpp
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
+#include <QtTest/QtTest>
+#include <UbuntuToolkit/private/uciconatlas_p.h>
+
+UT_USE_NAMESPACE
+
+static QImage icon(int width, int height, const QColor &color = Qt::red)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(color);
+    return image;
+}
+
+class tst_IconAtlas : public QObject
+{
+    Q_OBJECT
+
+private:
+    QOffscreenSurface *m_surface = Q_NULLPTR;
+    QOpenGLContext *m_context = Q_NULLPTR;
+
+    // Reads back a part of the atlas texture through a framebuffer object.
+    QImage readAtlas(quint32 textureId, const QRect &rect)
+    {
+        QOpenGLFunctions *gl = m_context->functions();
+        GLuint fbo;
+        gl->glGenFramebuffers(1, &fbo);
+        gl->glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        gl->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0);
+        QImage image;
+        if (gl->glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) {
+            image = QImage(rect.size(), QImage::Format_RGBA8888_Premultiplied);
+            gl->glReadPixels(rect.x(), rect.y(), rect.width(), rect.height(),
+                             GL_RGBA, GL_UNSIGNED_BYTE, image.bits());
+        }
+        gl->glBindFramebuffer(GL_FRAMEBUFFER, m_context->defaultFramebufferObject());
+        gl->glDeleteFramebuffers(1, &fbo);
+        return image;
+    }
+
+private Q_SLOTS:
+
+    void init()
+    {
+        m_surface = new QOffscreenSurface;
+        m_surface->create();
+        m_context = new QOpenGLContext;
+        if (!m_context->create() || !m_context->makeCurrent(m_surface)) {
+            QSKIP("This test requires OpenGL");
+        }
+    }
+
+    void cleanup()
+    {
+        if (m_context) {
+            m_context->makeCurrent(m_surface);
+        }
+        delete m_context;
+        m_context = Q_NULLPTR;
+        delete m_surface;
+        m_surface = Q_NULLPTR;
+    }
+
+    void test_shelves()
+    {
+        UCIconAtlas *atlas = UCIconAtlas::ref(m_context);
+        QImage small1 = icon(16, 16);
+        QImage small2 = icon(16, 16);
+
+        UCIconAtlasEntry *entry1 = atlas->acquire(small1);
+        QCOMPARE(entry1->rect, QRect(1, 1, 16, 16));
+        QCOMPARE(entry1->shelf, 0);
+        UCIconAtlasEntry *entry2 = atlas->acquire(small2);
+        QCOMPARE(entry2->rect, QRect(19, 1, 16, 16));
+        QCOMPARE(entry2->shelf, 0);
+
+        // too high for the first shelf
+        UCIconAtlasEntry *large = atlas->acquire(icon(32, 32));
+        QCOMPARE(large->rect, QRect(1, 19, 32, 32));
+        QCOMPARE(large->shelf, 1);
+
+        // slightly smaller icons share the first shelf, much smaller get a new one
+        UCIconAtlasEntry *smaller = atlas->acquire(icon(12, 12));
+        QCOMPARE(smaller->rect, QRect(37, 1, 12, 12));
+        QCOMPARE(smaller->shelf, 0);
+        UCIconAtlasEntry *tiny = atlas->acquire(icon(8, 8));
+        QCOMPARE(tiny->rect, QRect(1, 53, 8, 8));
+        QCOMPARE(tiny->shelf, 2);
+
+        // the same image is placed once
+        QCOMPARE(atlas->acquire(small1), entry1);
+        QCOMPARE(entry1->refCount, 2);
+
+        atlas->unref();
+    }
+
+    void test_padding()
+    {
+        UCIconAtlas *atlas = UCIconAtlas::ref(m_context);
+        atlas->acquire(icon(4, 4, Qt::blue));
+        const QImage pixels = readAtlas(atlas->textureId(), QRect(0, 0, 6, 6));
+        atlas->unref();
+        if (pixels.isNull()) {
+            QSKIP("The atlas texture can't be read back");
+        }
+
+        for (int y = 0; y < 6; y++) {
+            for (int x = 0; x < 6; x++) {
+                const bool border = x == 0 || y == 0 || x == 5 || y == 5;
+                QCOMPARE(pixels.pixel(x, y), border ? qRgba(0, 0, 0, 0) : qRgba(0, 0, 255, 255));
+            }
+        }
+    }
+
+    void test_eviction()
+    {
+        // 7 shelves of 7 icons of 130x130 padded pixels
+        UCIconAtlas *atlas = UCIconAtlas::ref(m_context);
+        QList<QImage> images;
+        QList<UCIconAtlasEntry*> entries;
+        for (int i = 0; i < 49; i++) {
+            images.append(icon(128, 128));
+            entries.append(atlas->acquire(images.last()));
+            QVERIFY(entries.last());
+            QCOMPARE(entries.last()->shelf, i / 7);
+        }
+        QVERIFY(!atlas->acquire(icon(128, 128)));
+
+        // empty the first shelf and take one icon out of the second
+        for (int i = 0; i < 8; i++) {
+            atlas->release(entries[i]);
+        }
+
+        // unused icons keep their place until it is needed
+        QCOMPARE(atlas->acquire(images[0]), entries[0]);
+        QCOMPARE(entries[0]->rect, QRect(1, 1, 128, 128));
+        atlas->release(entries[0]);
+
+        // the emptied shelf is reused, the evicted icons are placed again
+        UCIconAtlasEntry *entry = atlas->acquire(icon(128, 128));
+        QVERIFY(entry);
+        QCOMPARE(entry->rect, QRect(1, 1, 128, 128));
+        entry = atlas->acquire(images[7]);
+        QVERIFY(entry);
+        QCOMPARE(entry->rect, QRect(131, 1, 128, 128));
+
+        atlas->unref();
+    }
+
+    void test_fallback()
+    {
+        // too large
+        QVERIFY(!UCIconAtlasTexture::create(icon(129, 16)));
+        QVERIFY(!UCIconAtlasTexture::create(icon(16, 129)));
+        QVERIFY(!UCIconAtlasTexture::create(QImage()));
+
+        // no OpenGL context, as with the other scene graph backends
+        m_context->doneCurrent();
+        QVERIFY(!UCIconAtlasTexture::create(icon(16, 16)));
+        m_context->makeCurrent(m_surface);
+
+        // atlas full
+        QList<QSGTexture*> textures;
+        for (int i = 0; i < 49; i++) {
+            textures.append(UCIconAtlasTexture::create(icon(128, 128)));
+            QVERIFY(textures.last());
+        }
+        QVERIFY(!UCIconAtlasTexture::create(icon(128, 128)));
+        qDeleteAll(textures);
+    }
+
+    void test_normalizedTextureSubRect()
+    {
+        QScopedPointer<QSGTexture> texture1(UCIconAtlasTexture::create(icon(16, 32)));
+        QScopedPointer<QSGTexture> texture2(UCIconAtlasTexture::create(icon(16, 32)));
+        QVERIFY(texture1 && texture2);
+
+        QVERIFY(texture1->isAtlasTexture());
+        QCOMPARE(texture1->textureSize(), QSize(16, 32));
+        QCOMPARE(texture1->textureId(), texture2->textureId());
+        const qreal size = iconAtlasSize;
+        QCOMPARE(texture1->normalizedTextureSubRect(), QRectF(1 / size, 1 / size, 16 / size, 32 / size));
+        QCOMPARE(texture2->normalizedTextureSubRect(), QRectF(19 / size, 1 / size, 16 / size, 32 / size));
+    }
+
+    void test_texture_outlives_context()
+    {
+        QScopedPointer<QSGTexture> texture(UCIconAtlasTexture::create(icon(16, 16)));
+        QVERIFY(texture);
+        QVERIFY(texture->textureId() != 0);
+
+        delete m_context;
+        m_context = Q_NULLPTR;
+        QCOMPARE(texture->textureId(), 0);
+
+        // a new context gets a new atlas
+        m_context = new QOpenGLContext;
+        QVERIFY(m_context->create() && m_context->makeCurrent(m_surface));
+        QScopedPointer<QSGTexture> texture2(UCIconAtlasTexture::create(icon(16, 16)));
+        QVERIFY(texture2);
+        QVERIFY(texture2->textureId() != 0);
+        QCOMPARE(texture2->normalizedTextureSubRect().topLeft(), QPointF(1.0 / iconAtlasSize, 1.0 / iconAtlasSize));
+    }
+};
+
+QTEST_MAIN(tst_IconAtlas)
+
+#include "tst_iconatlas.moc"
@@ -27,11 +27,17 @@ class tst_IconProvider : public QObject
 public:
     tst_IconProvider() {}
 
+private:
+    QTemporaryDir cacheHome;
+
 private Q_SLOTS:
 
     void initTestCase()
     {
         qputenv("XDG_DATA_DIRS", SRCDIR);
+        // keep the rasterized icons away from the user cache
+        QVERIFY(cacheHome.isValid());
+        qputenv("XDG_CACHE_HOME", cacheHome.path().toLocal8Bit());
     }
 
     void test_loadIcon_data()
@@ -93,6 +99,72 @@ private Q_SLOTS:
         QVERIFY(!i.isNull());
         QCOMPARE(QColor(i.pixel(0,0)), QColor(Qt::black));
     }
+
+    void test_asynchronousIcon_data()
+    {
+        test_loadIcon_data();
+    }
+
+    void test_asynchronousIcon()
+    {
+        QFETCH(QString, icon);
+        QFETCH(QSize, requestSize);
+        QFETCH(QSize, resultSize);
+
+        UnityThemeIconProvider provider("mockTheme");
+        QScopedPointer<QQuickImageResponse> response(provider.requestImageResponse(icon, requestSize));
+        QSignalSpy finishedSpy(response.data(), SIGNAL(finished()));
+        QVERIFY(finishedSpy.wait());
+        QVERIFY(response->errorString().isEmpty());
+        QScopedPointer<QQuickTextureFactory> factory(response->textureFactory());
+        QCOMPARE(factory->image().size(), resultSize);
+    }
+
+    void test_iconThemeCache()
+    {
+        QTemporaryDir dataDir;
+        QVERIFY(dataDir.isValid());
+        const QString themeDir = dataDir.path() + "/icons/cachedTheme";
+        QVERIFY(QDir().mkpath(themeDir + "/apps/512"));
+
+        QFile index(themeDir + "/index.theme");
+        QVERIFY(index.open(QIODevice::WriteOnly));
+        index.write("[Icon Theme]\nName=CachedTheme\nDirectories=apps/512\n\n"
+                    "[apps/512]\nSize=512\nType=Fixed\n");
+        index.close();
+        QImage icon(16, 16, QImage::Format_ARGB32);
+        icon.fill(Qt::white);
+        QVERIFY(icon.save(themeDir + "/apps/512/cached-icon.png"));
+        QVERIFY(icon.save(themeDir + "/apps/512/uncached-icon.png"));
+
+        // icon-theme.cache listing cached-icon only
+        QByteArray cache;
+        QDataStream stream(&cache, QIODevice::WriteOnly);
+        stream << quint16(1) << quint16(0)  // version
+               << quint32(12) << quint32(20) // hash and directory list
+               << quint32(1) << quint32(28)  // hash: 1 bucket, icon
+               << quint32(1) << quint32(52)  // directory list: 1 directory
+               << quint32(0xffffffff) << quint32(64) << quint32(40) // icon: chain, name, images
+               << quint32(1) << quint16(0) << quint16(0x4) << quint32(0); // 1 png image in directory 0
+        cache.append("apps/512\0\0\0\0", 12);
+        cache.append("cached-icon\0", 12);
+        QFile cacheFile(themeDir + "/icon-theme.cache");
+        QVERIFY(cacheFile.open(QIODevice::WriteOnly));
+        cacheFile.write(cache);
+        cacheFile.close();
+
+        const QByteArray dataDirs = qgetenv("XDG_DATA_DIRS");
+        qputenv("XDG_DATA_DIRS", dataDir.path().toLocal8Bit() + ":" + dataDirs);
+        UnityThemeIconProvider provider("cachedTheme");
+        QSize returnedSize;
+        QImage cached = provider.requestImage("cached-icon", &returnedSize, QSize(-1, -1));
+        QImage uncached = provider.requestImage("uncached-icon", &returnedSize, QSize(-1, -1));
+        qputenv("XDG_DATA_DIRS", dataDirs);
+
+        QCOMPARE(cached.size(), QSize(16, 16));
+        // the up to date cache is trusted over the directory content
+        QVERIFY(uncached.isNull());
+    }
 };
 
 QTEST_MAIN(tst_IconProvider)
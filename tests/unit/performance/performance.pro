@@ -6,6 +6,7 @@ OTHER_FILES += \
     UbuntuShapeGrid.qml \
     ButtonStyleGrid.qml \
     PairOfUbuntuShapeGrid.qml \
+    ColoredUbuntuShapeGrid.qml \
     ButtonGrid.qml \
     CheckBoxStyleGrid.qml \
     CheckBoxGrid.qml \
@@ -45,4 +46,7 @@ OTHER_FILES += \
     ListOfListItemLayout_complex2.qml \
     ListOfListItemLayout_labelsOnly.qml \
     ListOfScrollbars_1_3.qml \
-    ListOfScrollView_bothScrollbars_1_3.qml
+    ListOfScrollView_bothScrollbars_1_3.qml \
+    ThemeSwitchScale.qml \
+    PaletteReconfiguration.qml \
+    StyleNameChange.qml
@@ -15,11 +15,93 @@
  */
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QString>
+#include <QtCore/QTemporaryDir>
+#include <QtQml/QQmlComponent>
 #include <QtQml/QQmlEngine>
 #include <QtQuick/QQuickItem>
 #include <QtQuick/QQuickView>
 #include <QtTest/QtTest>
+#include <UbuntuToolkit/ubuntutoolkitmodule.h>
+#define private public
+#include <UbuntuToolkit/private/uctheme_p.h>
+#undef private
+
+#include <cstddef>
+
+UT_USE_NAMESPACE
+
+// counts the heap allocations done through malloc(), calloc() and realloc(), in this
+// binary and the libraries, which includes operator new; the allocator functions of
+// the executable take precedence over the C library's ones, which they forward to
+static QBasicAtomicInt allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+#if defined(__GLIBC__)
+#define ALLOCATIONS_COUNTED
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) Q_DECL_NOTHROW
+{
+    allocationCount.ref();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) Q_DECL_NOTHROW
+{
+    allocationCount.ref();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) Q_DECL_NOTHROW
+{
+    allocationCount.ref();
+    return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+// measures the time and allocations of a benchmarked operation, reported per item
+class ItemCostMeter
+{
+public:
+    ItemCostMeter()
+        : m_elapsed(0), m_allocations(0), m_allocationsAtStart(0), m_iterations(0)
+    {
+    }
+
+    void start()
+    {
+        m_allocationsAtStart = allocationCount.load();
+        m_timer.start();
+    }
+    void stop()
+    {
+        m_elapsed += m_timer.nsecsElapsed();
+        m_allocations += allocationCount.load() - m_allocationsAtStart;
+        m_iterations++;
+    }
+
+    void report(int items)
+    {
+        const qreal count = qreal(qMax(1, items)) * qMax(1, m_iterations);
+#if defined(ALLOCATIONS_COUNTED)
+        qInfo("%s: %.1f heap allocations per item", QTest::currentDataTag(), m_allocations / count);
+#endif
+        QTest::setBenchmarkResult(m_elapsed / count, QTest::WalltimeNanoseconds);
+    }
+
+private:
+    QElapsedTimer m_timer;
+    qint64 m_elapsed;
+    qint64 m_allocations;
+    int m_allocationsAtStart;
+    int m_iterations;
+};
 
 class tst_Performance : public QObject
 {
@@ -97,6 +179,172 @@ private Q_SLOTS:
             delete root;
     }
 
+    // theme name changes, waiting for all themed items to get reloaded
+    void switchTheme(UCTheme *theme, const QString &name)
+    {
+        QSignalSpy reloadedSpy(theme, SIGNAL(themedItemsReloaded()));
+        theme->setName(name);
+        if (reloadedSpy.isEmpty()) {
+            reloadedSpy.wait(60000);
+        }
+    }
+
+    void benchmark_theme_switch_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("1k styled items") << 1000;
+        QTest::newRow("10k styled items") << 10000;
+    }
+    void benchmark_theme_switch()
+    {
+        QFETCH(int, count);
+
+        QQuickItem *root = loadDocument("ThemeSwitchScale.qml");
+        QVERIFY(root);
+        root->setProperty("count", count);
+        UCTheme *theme = root->property("theme").value<UCTheme*>();
+        QVERIFY(theme);
+
+        ItemCostMeter meter;
+        for (int i = 0; i < 4; i++) {
+            meter.start();
+            switchTheme(theme, (i % 2) ? "Ubuntu.Components.Themes.Ambiance" : "Ubuntu.Components.Themes.SuruDark");
+            meter.stop();
+        }
+        meter.report(count);
+        theme->resetName();
+        delete root;
+    }
+
+    void benchmark_palette_configuration_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("1k labels") << 1000;
+    }
+    void benchmark_palette_configuration()
+    {
+        QFETCH(int, count);
+
+        QQuickItem *root = loadDocument("PaletteReconfiguration.qml");
+        QVERIFY(root);
+        root->setProperty("count", count);
+        UCTheme *theme = root->findChild<UCTheme*>("theme");
+        QObject *firstPalette = root->findChild<QObject*>("firstPalette");
+        QObject *secondPalette = root->findChild<QObject*>("secondPalette");
+        QVERIFY(theme && firstPalette && secondPalette);
+
+        ItemCostMeter meter;
+        for (int i = 0; i < 10; i++) {
+            meter.start();
+            theme->setPalette((i % 2) ? secondPalette : firstPalette);
+            QCoreApplication::processEvents();
+            meter.stop();
+        }
+        meter.report(count);
+        delete root;
+    }
+
+    void benchmark_subtheming_depth_data()
+    {
+        QTest::addColumn<int>("depth");
+
+        QTest::newRow("8 nested ThemeSettings") << 8;
+        QTest::newRow("32 nested ThemeSettings") << 32;
+    }
+    void benchmark_subtheming_depth()
+    {
+        QFETCH(int, depth);
+
+        // each level follows the theme of its parent
+        QByteArray document("import QtQuick 2.4\nimport Ubuntu.Components 1.3\nStyledItem {\n");
+        for (int i = 0; i < depth; i++) {
+            document += "StyledItem { theme: ThemeSettings { name: parentTheme.name }\n";
+        }
+        document += QByteArray(depth + 1, '}');
+        QQmlComponent component(quickEngine);
+        component.setData(document, QUrl::fromLocalFile(QDir::currentPath() + "/NestedThemes.qml"));
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY2(root, qPrintable(component.errorString()));
+        UCTheme *theme = root->property("theme").value<UCTheme*>();
+        QVERIFY(theme);
+
+        ItemCostMeter meter;
+        for (int i = 0; i < 4; i++) {
+            meter.start();
+            switchTheme(theme, (i % 2) ? "Ubuntu.Components.Themes.Ambiance" : "Ubuntu.Components.Themes.SuruDark");
+            QCoreApplication::processEvents();
+            meter.stop();
+        }
+        meter.report(depth);
+        theme->resetName();
+    }
+
+    void benchmark_style_name_change_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("100 buttons") << 100;
+    }
+    void benchmark_style_name_change()
+    {
+        QFETCH(int, count);
+
+        QQuickItem *root = loadDocument("StyleNameChange.qml");
+        QVERIFY(root);
+        root->setProperty("count", count);
+
+        ItemCostMeter meter;
+        for (int i = 0; i < 10; i++) {
+            meter.start();
+            root->setProperty("buttonStyle", (i % 2) ? "ButtonStyle" : "");
+            QCoreApplication::processEvents();
+            meter.stop();
+        }
+        meter.report(count);
+        delete root;
+    }
+
+    void benchmark_style_lookup_data()
+    {
+        QTest::addColumn<int>("parentCount");
+
+        QTest::newRow("1 parent theme") << 1;
+        QTest::newRow("8 parent themes") << 8;
+        QTest::newRow("32 parent themes") << 32;
+    }
+    void benchmark_style_lookup()
+    {
+        QFETCH(int, parentCount);
+
+        // a chain of themes without styles, only Ambiance has the looked up style
+        QTemporaryDir themes;
+        QVERIFY(themes.isValid());
+        for (int i = 0; i < parentCount; i++) {
+            QDir(themes.path()).mkdir(QString("Theme%1").arg(i));
+            QFile parentTheme(QString("%1/Theme%2/parent_theme").arg(themes.path()).arg(i));
+            QVERIFY(parentTheme.open(QIODevice::WriteOnly));
+            parentTheme.write(i ? QString("Theme%1").arg(i - 1).toLatin1() : QByteArray("Ubuntu.Components.Themes.Ambiance"));
+        }
+        QByteArray themesPath = qgetenv("UBUNTU_UI_TOOLKIT_THEMES_PATH");
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", QString("%1:%2").arg(themes.path()).arg(UBUNTU_QML_IMPORT_PATH).toLocal8Bit());
+
+        UCTheme theme;
+        theme.setName(QString("Theme%1").arg(parentCount - 1));
+        QCOMPARE(theme.m_themePaths.count(), parentCount + 1);
+
+        ItemCostMeter meter;
+        const int lookups = 1000;
+        meter.start();
+        for (int i = 0; i < lookups; i++) {
+            QVERIFY(theme.styleUrl("ButtonStyle.qml", LATEST_UITK_VERSION).isValid());
+        }
+        meter.stop();
+        meter.report(lookups);
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", themesPath);
+    }
+
     void benchmark_GridOfComponents_data() {
         QTest::addColumn<QString>("document");
         QTest::addColumn<QUrl>("theme");
@@ -110,6 +358,7 @@ private Q_SLOTS:
         QTest::newRow("grid with Label 1.3") << "LabelGrid13.qml" << QUrl();
         QTest::newRow("grid with UbuntuShape") << "UbuntuShapeGrid.qml" << QUrl();
         QTest::newRow("grid with UbuntuShapePair") << "PairOfUbuntuShapeGrid.qml" << QUrl();
+        QTest::newRow("grid with colored UbuntuShape") << "ColoredUbuntuShapeGrid.qml" << QUrl();
         QTest::newRow("grid with Button") << "ButtonGrid.qml" << QUrl();
         QTest::newRow("grid with Slider") << "SliderGrid.qml" << QUrl();
         QTest::newRow("list with QtQuick Item") << "ItemList.qml" << QUrl();
@@ -16,6 +16,7 @@
  * Author: Florian Boucault <florian.boucault@canonical.com>
  */
 
+#include <QtQml/QQmlComponent>
 #include <QtQml/QQmlEngine>
 #include <QtQuick/private/qquickimagebase_p.h>
 #include <QtTest/QtTest>
@@ -23,6 +24,7 @@
 #define protected public
 #include <UbuntuToolkit/private/ucqquickimageextension_p.h>
 #undef protected
+#include <UbuntuToolkit/private/ucunits_p.h>
 #include <QtCore/private/qabstractfileengine_p.h>
 #include <QQuickView>
 
@@ -55,6 +57,21 @@ class tst_UCQQuickImageExtension : public QObject
 private:
     QQmlEngine *engine = Q_NULLPTR;
 
+    // Creates a BorderImage loading @source, relative to the data folder.
+    QObject *createBorderImage(const QString &source)
+    {
+        QQmlComponent component(engine);
+        component.setData("import QtQuick 2.4\n"
+                          "import Ubuntu.Components 1.3\n"
+                          "BorderImage { width: 100; height: 100; source: \"" + source.toUtf8() + "\" }",
+                          QUrl::fromLocalFile(QFileInfo("data/border_image.qml").absoluteFilePath()));
+        QObject *image = component.create();
+        if (!image) {
+            qWarning() << component.errors();
+        }
+        return image;
+    }
+
 private Q_SLOTS:
 
     void init()
@@ -92,53 +109,78 @@ private Q_SLOTS:
         QCOMPARE(result, expected);
     }
 
-    void rewriteContainsBorderInName() {
+    void scaleContainsBorderInName() {
         UCQQuickImageExtension image;
-        QString sciFilePath = "data/borderInName.sci";
-        QString result;
-
-        QTextStream resultStream(&result);
-        image.rewriteSciFile(sciFilePath, "1", resultStream);
-
-        QString expected;
-        QTextStream expectedStream(&expected);
-        expectedStream << "source: \"image://scaling/1/data/borderInName.png\"" << endl;
-        expectedStream << "border.left: 9" << endl;
-        expectedStream << "border.right: 2" << endl;
-        expectedStream << "border.top: 9" << endl;
-        expectedStream << "border.bottom: 0" << endl;
-        expectedStream << "horizontalTileMode: Stretch" << endl;
-        expectedStream << "verticalTileMode: Stretch" << endl;
+        UCQQuickImageExtension::ScaledSci sci;
+        QVERIFY(image.scaleSciFile("data/borderInName.sci", "1", &sci));
+
+        QCOMPARE(sci.source, QUrl("image://scaling/1/data/borderInName.png"));
+        QCOMPARE(sci.left, 9);
+        QCOMPARE(sci.right, 2);
+        QCOMPARE(sci.top, 9);
+        QCOMPARE(sci.bottom, 0);
+        QCOMPARE(sci.horizontalTileMode, Qt::StretchTile);
+        QCOMPARE(sci.verticalTileMode, Qt::StretchTile);
+    }
 
-        QCOMPARE(result, expected);
+    void scaleSciFileHalf() {
+        UCQQuickImageExtension image;
+        UCQQuickImageExtension::ScaledSci sci;
+        QVERIFY(image.scaleSciFile("data/test@18.sci", "0.5", &sci));
+
+        QCOMPARE(sci.source, QUrl("image://scaling/0.5/data/test@18.png"));
+        QCOMPARE(sci.left, 5);
+        QCOMPARE(sci.right, 1);
+        QCOMPARE(sci.top, 5);
+        QCOMPARE(sci.bottom, 0);
+
+        QVERIFY(!image.scaleSciFile("data/nonexistent.sci", "1", &sci));
     }
 
-    void cachingOfRewrittenSciFiles() {
-        /* This tests an internal implementation detail of UCQQuickImageExtension,
-           namely making sure that only one temporary rewritten .sci file is
-           created for each source .sci file.
+    void noTemporarySciFiles() {
+        /* Scaled .sci files are applied from memory, none is written to the
+           temporary folder.
         */
-        QQuickImageBase baseImage;
-        UCQQuickImageExtension* image1 = new UCQQuickImageExtension(&baseImage);
-        UCQQuickImageExtension* image2 = new UCQQuickImageExtension(&baseImage);
-        QUrl sciFileUrl = QUrl::fromLocalFile("./data/test.sci");
-
         unsigned int initialNumberOfSciFiles = numberOfTemporarySciFiles();
 
-        image1->setSource(sciFileUrl);
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
-
-        image2->setSource(sciFileUrl);
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
+        QScopedPointer<QObject> image1(createBorderImage("frame.sci"));
+        QScopedPointer<QObject> image2(createBorderImage("frame.sci"));
+        QVERIFY(image1 && image2);
+        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles);
+    }
 
-        delete image1;
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
+    void borderImageGridUnitSci_data() {
+        QTest::addColumn<QString>("source");
+        QTest::addColumn<QString>("fragment");
 
-        /* The temporary files will be deleted when the cache is destroyed when
-           the application exits.
-        */
-        delete image2;
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
+        QTest::newRow("no fragment") << "frame.sci" << QString();
+        QTest::newRow("fragment") << "frame.sci#0" << "0";
+    }
+    void borderImageGridUnitSci() {
+        QFETCH(QString, source);
+        QFETCH(QString, fragment);
+
+        // frame@18.sci scaled down by half
+        const float gridUnit = UCUnits::instance()->gridUnit();
+        UCUnits::instance()->setGridUnit(9);
+        QScopedPointer<QObject> image(createBorderImage(source));
+        UCUnits::instance()->setGridUnit(gridUnit);
+        QVERIFY(image);
+
+        QObject *border = image->property("border").value<QObject*>();
+        QVERIFY(border);
+        QCOMPARE(border->property("left").toInt(), 5);
+        QCOMPARE(border->property("right").toInt(), 2);
+        QCOMPARE(border->property("top").toInt(), 3);
+        QCOMPARE(border->property("bottom").toInt(), 1);
+        QCOMPARE(image->property("horizontalTileMode").toInt(), int(Qt::RepeatTile));
+        QCOMPARE(image->property("verticalTileMode").toInt(), int(Qt::RoundTile));
+
+        QUrl expected("image://scaling/0.5/" + QFileInfo("data/frame@18.sci").absolutePath() + "/face.png");
+        if (!fragment.isEmpty()) {
+            expected.setFragment(fragment);
+        }
+        QCOMPARE(image->property("source").toUrl(), expected);
     }
 
     void onlyOneStatRepeatedImage() {
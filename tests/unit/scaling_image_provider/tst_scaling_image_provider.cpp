@@ -17,6 +17,7 @@
  */
 
 #include <QtTest/QtTest>
+#include <UbuntuToolkit/private/ucimagediskcache_p.h>
 #include <UbuntuToolkit/private/ucscalingimageprovider_p.h>
 
 UT_USE_NAMESPACE
@@ -25,8 +26,16 @@ class tst_UCScalingImageProvider: public QObject
 {
     Q_OBJECT
 
+    QTemporaryDir cacheHome;
+
 private Q_SLOTS:
 
+    void initTestCase() {
+        // keep the scaled images away from the user cache
+        QVERIFY(cacheHome.isValid());
+        qputenv("XDG_CACHE_HOME", cacheHome.path().toLocal8Bit());
+    }
+
     void scaleToHalfSize() {
         UCScalingImageProvider provider;
         QImage result;
@@ -93,6 +102,88 @@ private Q_SLOTS:
         QCOMPARE(size, returnedSize);
         QCOMPARE(result.size(), resultSize);
     }
+
+    void asynchronousResponse() {
+        UCScalingImageProvider provider;
+        QString id("0.5/" + QDir::currentPath() + QDir::separator() + "input.png");
+
+        QScopedPointer<QQuickImageResponse> response(provider.requestImageResponse(id, QSize()));
+        QSignalSpy finishedSpy(response.data(), SIGNAL(finished()));
+        QVERIFY(finishedSpy.wait());
+        QVERIFY(response->errorString().isEmpty());
+        QScopedPointer<QQuickTextureFactory> factory(response->textureFactory());
+        QCOMPARE(factory->image(), QImage("scaled_half.png"));
+    }
+
+    void identicalRequestsShareDecoding() {
+        UCScalingImageProvider provider;
+        QString id("0.5/" + QDir::currentPath() + QDir::separator() + "input.png");
+
+        QScopedPointer<QQuickImageResponse> first(provider.requestImageResponse(id, QSize()));
+        QScopedPointer<QQuickImageResponse> cancelled(provider.requestImageResponse(id, QSize()));
+        cancelled->cancel();
+        QScopedPointer<QQuickImageResponse> second(provider.requestImageResponse(id, QSize()));
+        QSignalSpy cancelledSpy(cancelled.data(), SIGNAL(finished()));
+        QSignalSpy firstSpy(first.data(), SIGNAL(finished()));
+        QSignalSpy secondSpy(second.data(), SIGNAL(finished()));
+
+        QVERIFY(firstSpy.wait());
+        if (secondSpy.isEmpty()) {
+            QVERIFY(secondSpy.wait());
+        }
+        QCoreApplication::processEvents();
+        QCOMPARE(cancelledSpy.count(), 0);
+        QScopedPointer<QQuickTextureFactory> firstFactory(first->textureFactory());
+        QScopedPointer<QQuickTextureFactory> secondFactory(second->textureFactory());
+        QCOMPARE(firstFactory->image(), secondFactory->image());
+    }
+
+    void diskCacheRoundTrip() {
+        QTemporaryDir path;
+        UCImageDiskCache cache(path.path());
+        QString key = UCImageDiskCache::key(QDir::currentPath() + QDir::separator() + "input.png", "test");
+        QVERIFY(!key.isEmpty());
+        QVERIFY(cache.load(key).isNull());
+
+        QImage image = QImage("scaled_half.png").convertToFormat(QImage::Format_ARGB32);
+        cache.store(key, image, QSize(42, 24));
+        QSize size;
+        QImage cached = cache.load(key, &size);
+        QCOMPARE(cached, image);
+        QCOMPARE(size, QSize(42, 24));
+
+        // resources are not cached
+        QVERIFY(UCImageDiskCache::key(":/test/prefix/input.png", "test").isEmpty());
+    }
+
+    void diskCacheEviction() {
+        QTemporaryDir path;
+        QImage image(16, 16, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        // room for a bit less than three entries
+        const qint64 entrySize = 32 + image.bytesPerLine() * image.height();
+        UCImageDiskCache cache(path.path(), entrySize * 28 / 10);
+
+        cache.store("first", image, image.size());
+        QFile first(cache.path() + "first");
+        QVERIFY(first.open(QIODevice::ReadWrite));
+        QVERIFY(first.setFileTime(QDateTime::currentDateTime().addSecs(-3600), QFileDevice::FileModificationTime));
+        first.close();
+        cache.store("second", image, image.size());
+        cache.store("third", image, image.size());
+
+        QVERIFY(cache.load("first").isNull());
+        QVERIFY(!cache.load("second").isNull());
+        QVERIFY(!cache.load("third").isNull());
+    }
+
+    void invalidImageResponse() {
+        UCScalingImageProvider provider;
+        QScopedPointer<QQuickImageResponse> response(provider.requestImageResponse("1/nonexistent.png", QSize()));
+        QSignalSpy finishedSpy(response.data(), SIGNAL(finished()));
+        QVERIFY(finishedSpy.wait());
+        QVERIFY(!response->errorString().isEmpty());
+    }
 };
 
 QTEST_MAIN(tst_UCScalingImageProvider)
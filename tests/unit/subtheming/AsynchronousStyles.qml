@@ -0,0 +1,55 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+StyledItem {
+    width: units.gu(40)
+    height: units.gu(40)
+    theme: ThemeSettings {
+        name: "TestModule.TestTheme"
+    }
+
+    Column {
+        StyledItem {
+            objectName: "hidden1"
+            visible: false
+            width: units.gu(10)
+            height: units.gu(5)
+            asynchronousStyle: true
+        }
+        StyledItem {
+            objectName: "shown1"
+            width: units.gu(10)
+            height: units.gu(5)
+            asynchronousStyle: true
+        }
+        StyledItem {
+            objectName: "hidden2"
+            visible: false
+            width: units.gu(10)
+            height: units.gu(5)
+            asynchronousStyle: true
+        }
+        StyledItem {
+            objectName: "shown2"
+            width: units.gu(10)
+            height: units.gu(5)
+            asynchronousStyle: true
+        }
+    }
+}
@@ -5,6 +5,8 @@ SOURCES += tst_subtheming.cpp
 OTHER_FILES += \
     TestStyle.qml \
     SimpleItem.qml \
+    AsynchronousStyles.qml \
+    DeferredStyleInFlickable.qml \
     themes/CustomTheme/TestStyle.qml \
     themes/CustomTheme/Palette.qml \
     themes/CustomTheme/parent_theme \
@@ -42,12 +44,19 @@ OTHER_FILES += \
     MoreStyleHints.qml \
     GroupPropertyBindingHints.qml \
     GroupPropertyValueHints.qml \
+    SharedStyleHints.qml \
     OverrideStyleHints.qml \
     HintedButton.qml \
     OtherVersion.qml \
     DefaultTheme.qml \
     themes/DerivedTheme/parent_theme \
     themes/DerivedTheme/1.2/TestStyle.qml \
-    themes/DerivedTheme/1.3/Palette.qml
+    themes/DerivedTheme/1.3/Palette.qml \
+    themes/ManifestTheme/theme_manifest \
+    themes/ManifestTheme/qmldir \
+    themes/ManifestTheme/FlatStyle.qml \
+    themes/ManifestTheme/1.2/ManifestStyle.qml \
+    themes/ManifestTheme/1.3/ManifestStyle.qml \
+    themes/ManifestTheme/1.3/TestStyle.qml
 
 
@@ -27,6 +27,7 @@
 #define private public
 #define protected public
 #include <UbuntuToolkit/private/uctheme_p.h>
+#include <UbuntuToolkit/private/ucstylehints_p.h>
 #undef protected
 #undef private
 
@@ -217,6 +218,116 @@ private Q_SLOTS:
         QCOMPARE(testStyle != NULL, success);
     }
 
+    void test_shared_style_component()
+    {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "./themes");
+
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("SimpleItem.qml"));
+        view->setTheme("TestModule.TestTheme", view->rootObject());
+        UCTheme *theme = view->theme();
+        QVERIFY(theme);
+
+        QQmlComponent *first = theme->sharedStyleComponent("TestStyle.qml", view->rootObject(), BUILD_VERSION(1, 3));
+        QQmlComponent *second = theme->sharedStyleComponent("TestStyle.qml", view->rootObject(), BUILD_VERSION(1, 3));
+        QVERIFY(first);
+        QCOMPARE(first, second);
+        QCOMPARE(theme->m_styleCache.size(), 1);
+
+        // changing the theme drops the cached components
+        theme->setName("CustomTheme");
+        QCOMPARE(theme->m_styleCache.size(), 0);
+    }
+
+    void test_asynchronous_style()
+    {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "./themes");
+
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("SimpleItem.qml"));
+        view->setTheme("TestModule.TestTheme", view->rootObject());
+        view->rootObject()->setProperty("asynchronousStyle", true);
+
+        QSignalSpy spy(view->rootObject(), SIGNAL(styleInstanceChanged()));
+        view->rootObject()->setProperty("styleName", "TestStyle");
+        // the style is not there yet
+        QVERIFY(!view->rootObject()->findChild<QQuickItem*>("TestStyle"));
+        QVERIFY(spy.wait());
+        QVERIFY(view->rootObject()->findChild<QQuickItem*>("TestStyle"));
+    }
+
+    void test_asynchronous_style_order()
+    {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "./themes");
+
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("AsynchronousStyles.qml"));
+        // request hidden and shown items interleaved
+        QStringList requests;
+        requests << "hidden1" << "shown1" << "hidden2" << "shown2";
+        QStringList completed;
+        Q_FOREACH(const QString &name, requests) {
+            UCStyledItemBase *item = view->findItem<UCStyledItemBase*>(name);
+            connect(item, &UCStyledItemBase::styleInstanceChanged, [&completed, name]() {
+                completed << name;
+            });
+            item->setProperty("styleName", "TestStyle");
+        }
+        QTRY_COMPARE(completed.size(), requests.size());
+
+        // shown items get their styles first, each group in the order of the requests
+        QStringList expected;
+        expected << "shown1" << "shown2" << "hidden1" << "hidden2";
+        QCOMPARE(completed, expected);
+    }
+
+    void test_deferred_style()
+    {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "./themes");
+
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("SimpleItem.qml"));
+        view->setTheme("TestModule.TestTheme", view->rootObject());
+        UCStyledItemBase *item = qobject_cast<UCStyledItemBase*>(view->rootObject());
+        QVERIFY(item);
+        item->setProperty("deferredStyle", true);
+        item->setVisible(false);
+        item->setProperty("styleName", "TestStyle");
+        QVERIFY(!UCStyledItemBasePrivate::get(item)->styleItem);
+
+        // shown, style gets loaded with the next frame
+        QSignalSpy spy(item, SIGNAL(styleInstanceChanged()));
+        item->setVisible(true);
+        QVERIFY(spy.wait());
+        QVERIFY(UCStyledItemBasePrivate::get(item)->styleItem);
+
+        // hidden styles can be released
+        item->setVisible(false);
+        UCStyledItemBasePrivate::releaseHiddenStyles();
+        QVERIFY(!UCStyledItemBasePrivate::get(item)->styleItem);
+    }
+
+    void test_deferred_style_in_flickable()
+    {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "./themes");
+
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("DeferredStyleInFlickable.qml"));
+        QQuickItem *flickable = view->findItem<QQuickItem*>("flickable");
+        UCStyledItemBase *item = view->findItem<UCStyledItemBase*>("deferred");
+        UCStyledItemBasePrivate *d = UCStyledItemBasePrivate::get(item);
+        QVERIFY(d->styleLoadPending);
+        // checked once, then frames are not watched until something changes
+        QTRY_VERIFY(!d->watchedWindow);
+        QVERIFY(!d->styleItem);
+        QVERIFY(d->visibilityWatcher);
+
+        // scrolling the content moves the item into the window
+        QSignalSpy spy(item, SIGNAL(styleInstanceChanged()));
+        flickable->setProperty("contentY", UCUnits::instance()->gu(90));
+        QVERIFY(d->watchedWindow);
+        QVERIFY(spy.wait());
+        QVERIFY(d->styleItem);
+        QVERIFY(!d->styleLoadPending);
+        QVERIFY(!d->visibilityWatcher);
+        QVERIFY(!d->watchedWindow);
+    }
+
     void test_relative_theme_paths_environment_variables_data()
     {
         QTest::addColumn<QString>("themePath");
@@ -916,6 +1027,24 @@ private Q_SLOTS:
         QCOMPARE(pressedColor, colorPressed);
     }
 
+    void test_stylehints_shared_by_instances()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("SharedStyleHints.qml"));
+        QList<UCStyleHints*> hints = view->rootObject()->findChildren<UCStyleHints*>();
+        QCOMPARE(hints.count(), 3);
+        for (int i = 0; i < hints.count(); i++) {
+            QVERIFY(hints[i]->m_program);
+            QCOMPARE(hints[i]->m_program.data(), hints[0]->m_program.data());
+
+            UCStyledItemBase *button = view->findItem<UCStyledItemBase*>(QString("Button%1").arg(i));
+            QQuickItem *styleItem = UCStyledItemBasePrivate::get(button)->styleItem;
+            QVERIFY(styleItem);
+            QCOMPARE(styleItem->property("defaultColor").value<QColor>(), QColor("blue"));
+        }
+        QCOMPARE(hints[0]->m_program->expressions.count(), 1);
+        QCOMPARE(hints[0]->m_program->values.count(), 1);
+    }
+
     void test_derived_theme_fallback_should_use_proper_style_bug1555797() {
         qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "");
         qputenv("XDG_DATA_DIRS", "./themes:./themes/TestModule");
@@ -930,6 +1059,121 @@ private Q_SLOTS:
         QUrl style = theme->styleUrl("TestStyle.qml", BUILD_VERSION(1, 3), &fallback);
         QVERIFY(style.toString().endsWith("TestTheme/1.3/TestStyle.qml"));
     }
+
+    void test_theme_folder_index() {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "");
+        qputenv("XDG_DATA_DIRS", "./themes:./themes/TestModule");
+
+        UCTheme::ThemeRecord record = pathFromThemeName("CustomTheme");
+        QVERIFY(record.isValid());
+        QCOMPARE(record.parentTheme, QString("TestTheme"));
+        QVERIFY(!record.shared);
+        QVERIFY(record.files.contains("TestStyle.qml"));
+        QVERIFY(record.files.contains("1.3/TestStyle.qml"));
+        QVERIFY(!record.files.contains("1.2/TestStyle.qml"));
+
+        record = pathFromThemeName("TestTheme");
+        QVERIFY(record.shared);
+        QVERIFY(record.files.contains("1.2/TestStyle.qml"));
+    }
+
+    void test_theme_manifest() {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "");
+        qputenv("XDG_DATA_DIRS", "./themes:./themes/TestModule");
+
+        // ManifestTheme has no parent_theme nor deprecated file, and 1.3/TestStyle.qml
+        // is not listed; all of these come from the manifest only
+        UCTheme::ThemeRecord record = pathFromThemeName("ManifestTheme");
+        QVERIFY(record.isValid());
+        QCOMPARE(record.parentTheme, QString("TestTheme"));
+        QVERIFY(record.shared);
+        QVERIFY(record.deprecated);
+        QCOMPARE(record.files.size(), 4);
+        QVERIFY(record.files.contains("FlatStyle.qml"));
+        QVERIFY(record.files.contains("1.2/ManifestStyle.qml"));
+        QVERIFY(record.files.contains("1.3/ManifestStyle.qml"));
+        QVERIFY(record.files.contains("qmldir"));
+        QVERIFY(!record.files.contains("1.3/TestStyle.qml"));
+
+        QQmlEngine engine;
+        UbuntuToolkitModule::initializeContextProperties(&engine);
+        QScopedPointer<UCTheme> theme(new UCTheme);
+        theme->setName("ManifestTheme");
+        QCOMPARE(theme->m_themePaths.size(), 2);
+
+        QUrl style = theme->styleUrl("ManifestStyle.qml", BUILD_VERSION(1, 3));
+        QVERIFY(style.toString().endsWith("ManifestTheme/1.3/ManifestStyle.qml"));
+        style = theme->styleUrl("ManifestStyle.qml", BUILD_VERSION(1, 2));
+        QVERIFY(style.toString().endsWith("ManifestTheme/1.2/ManifestStyle.qml"));
+        // non-versioned styles are looked up in deprecated themes
+        style = theme->styleUrl("FlatStyle.qml", BUILD_VERSION(1, 3));
+        QVERIFY(style.toString().endsWith("ManifestTheme/FlatStyle.qml"));
+        // files missing from the manifest are taken from the parent theme
+        style = theme->styleUrl("TestStyle.qml", BUILD_VERSION(1, 3));
+        QVERIFY(style.toString().endsWith("TestModule/TestTheme/1.3/TestStyle.qml"));
+    }
+
+    void test_theme_without_manifest_scanned() {
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", "");
+        qputenv("XDG_DATA_DIRS", "./themes:./themes/TestModule");
+
+        UCTheme::ThemeRecord record = pathFromThemeName("CustomTheme");
+        QVERIFY(record.isValid());
+        QVERIFY(!record.files.contains("theme_manifest"));
+        QVERIFY(record.files.contains("parent_theme"));
+
+        QQmlEngine engine;
+        UbuntuToolkitModule::initializeContextProperties(&engine);
+        QScopedPointer<UCTheme> theme(new UCTheme);
+        theme->setName("CustomTheme");
+        QCOMPARE(theme->m_themePaths.size(), 2);
+
+        QUrl style = theme->styleUrl("TestStyle.qml", BUILD_VERSION(1, 3));
+        QVERIFY(style.toString().endsWith("CustomTheme/1.3/TestStyle.qml"));
+        style = theme->styleUrl("TestStyle.qml", BUILD_VERSION(1, 2));
+        QVERIFY(style.toString().endsWith("CustomTheme/TestStyle.qml"));
+    }
+
+    void test_compiled_palette_colors()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("MultiplePaletteInstances.qml"));
+        UCTheme *theme = view->findItem<UCTheme*>("theme");
+        QObject *palette1 = view->findItem<QObject*>("palette1");
+        QObject *normal = theme->palette()->property("normal").value<QObject*>();
+        QVERIFY(normal);
+
+        QCOMPARE(theme->paletteColor(UCTheme::Normal, UCTheme::Background), normal->property("background").value<QColor>());
+        QCOMPARE(theme->paletteColor(UCTheme::Disabled, UCTheme::FocusText), theme->getPaletteColor("disabled", "focusText"));
+
+        // the compiled colors follow palette value changes and configuration
+        normal->setProperty("background", QColor("green"));
+        QCOMPARE(theme->paletteColor(UCTheme::Normal, UCTheme::Background), QColor("green"));
+        theme->setPalette(palette1);
+        QCOMPARE(theme->paletteColor(UCTheme::Normal, UCTheme::Background), QColor("blue"));
+    }
+
+    void test_hidden_items_reloaded_later()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("TestMain.qml"));
+        UCTheme *theme = view->globalTheme();
+        UCStyledItemBase *shown = view->findItem<UCStyledItemBase*>("firstLevelStyled");
+        UCStyledItemBase *hidden = view->findItem<UCStyledItemBase*>("secondLevelStyled");
+        UCStyledItemBase *main = qobject_cast<UCStyledItemBase*>(view->rootObject());
+        hidden->setVisible(false);
+
+        QSignalSpy reloadedSpy(theme, SIGNAL(themedItemsReloaded()));
+        view->setGlobalTheme("Ubuntu.Components.Themes.SuruDark");
+        QVERIFY(!theme->isReloadPending(shown));
+        QVERIFY(!theme->isReloadPending(main));
+        QVERIFY(theme->isReloadPending(hidden));
+        QCOMPARE(reloadedSpy.count(), 0);
+
+        // showing the item reloads it before its turn
+        hidden->setVisible(true);
+        QVERIFY(!theme->isReloadPending(hidden));
+        UbuntuTestCase::waitForSignal(&reloadedSpy);
+        QCOMPARE(reloadedSpy.count(), 1);
+    }
 };
 
 QTEST_MAIN(tst_Subtheming)
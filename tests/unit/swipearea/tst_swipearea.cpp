@@ -124,6 +124,12 @@ private Q_SLOTS:
     void makoLeftEdgeDrag_movesSlightlyBackwardsOnStart();
     void grabGesture();
     void grabGestureWithImmediateRecognition();
+    void velocity();
+    void earlyRecognition();
+    void earlyRecognition_data();
+    void distanceRecognition();
+    void distanceRecognition_data();
+    void earlyRecognitionProperty();
 
 private:
     // QTest::touchEvent takes QPoint instead of QPointF and I don't want to
@@ -1446,6 +1452,207 @@ void tst_UCSwipeArea::grabGestureWithImmediateRecognition()
     sendTouchRelease(timestamp, 0, touchPoint);
 }
 
+/*
+    Checks that the velocity of the touch point along the gesture direction is
+    estimated and kept after the touch point is released.
+ */
+void tst_UCSwipeArea::velocity()
+{
+    UCSwipeArea *edgeDragArea =
+        m_view->rootObject()->findChild<UCSwipeArea*>("hpDragArea");
+    QVERIFY(edgeDragArea != 0);
+    UCSwipeAreaPrivate *d = UCSwipeAreaPrivate::get(edgeDragArea);
+    d->setRecognitionTimer(m_fakeTimerFactory->createTimer(edgeDragArea));
+    d->setTimeSource(m_fakeTimerFactory->timeSource());
+
+    QSignalSpy velocitySpy(edgeDragArea, &UCSwipeArea::velocityChanged);
+
+    QPointF touchPoint = calculateInitialtouchPosition(edgeDragArea);
+
+    // 0.5 pixels per millisecond rightwards, with some vertical drift
+    QPointF touchMovement(5., 1.);
+    int movementTimeStepMs = 10;
+    qint64 timestamp = 0;
+
+    sendTouchPress(timestamp, 0, touchPoint);
+    QCOMPARE(edgeDragArea->velocity(), 0.);
+
+    for (int i = 0; i < 20; ++i) {
+        touchPoint += touchMovement;
+        timestamp += movementTimeStepMs;
+        sendTouchUpdate(timestamp, 0, touchPoint);
+    }
+
+    QCOMPARE((int)d->status, (int)UCSwipeAreaPrivate::Recognized);
+    QVERIFY(velocitySpy.count() > 0);
+    // NB: qFuzzyCompare(), used internally by QCOMPARE(), is broken.
+    QVERIFY(qAbs(edgeDragArea->velocity() - 500.) < 1.);
+
+    timestamp += movementTimeStepMs;
+    touchPoint += touchMovement;
+    sendTouchRelease(timestamp, 0, touchPoint);
+
+    QCOMPARE((int)d->status, (int)UCSwipeAreaPrivate::WaitingForTouch);
+    QVERIFY(qAbs(edgeDragArea->velocity() - 500.) < 1.);
+}
+
+/*
+    A touch point moving fast enough along the gesture direction should get
+    recognized before crossing the distance threshold, but not before the
+    composition time is over.
+ */
+void tst_UCSwipeArea::earlyRecognition()
+{
+    QFETCH(qreal, speedFactor);
+    QFETCH(bool, recognized);
+
+    UCSwipeArea *edgeDragArea =
+        m_view->rootObject()->findChild<UCSwipeArea*>("hpDragArea");
+    QVERIFY(edgeDragArea != 0);
+    UCSwipeAreaPrivate *d = UCSwipeAreaPrivate::get(edgeDragArea);
+    d->setRecognitionTimer(m_fakeTimerFactory->createTimer(edgeDragArea));
+    d->setTimeSource(m_fakeTimerFactory->timeSource());
+
+    // Disable some constraints we're not interested in
+    d->setMaxTime(60 * 1000);
+
+    // Move so that the distance threshold is only reached after twice the composition time,
+    // in pixels per millisecond
+    qreal speed = d->distanceThreshold / (d->compositionTime * 2.);
+    d->setEarlyRecognitionSpeed(speed * 1000. * speedFactor);
+
+    QPointF touchPoint = calculateInitialtouchPosition(edgeDragArea);
+    int movementTimeStepMs = 5;
+    QPointF touchMovement(speed * movementTimeStepMs, 0.);
+    qint64 timestamp = 0;
+
+    sendTouchPress(timestamp, 0, touchPoint);
+
+    while (timestamp + movementTimeStepMs <= d->compositionTime) {
+        touchPoint += touchMovement;
+        timestamp += movementTimeStepMs;
+        sendTouchUpdate(timestamp, 0, touchPoint);
+        QCOMPARE((int)d->status, (int)UCSwipeAreaPrivate::Undecided);
+    }
+
+    touchPoint += touchMovement;
+    timestamp += movementTimeStepMs;
+    sendTouchUpdate(timestamp, 0, touchPoint);
+
+    QVERIFY(touchPoint.x() - calculateInitialtouchPosition(edgeDragArea).x() < d->distanceThreshold);
+    QCOMPARE(d->status == UCSwipeAreaPrivate::Recognized, recognized);
+    QCOMPARE(edgeDragArea->dragging(), recognized);
+
+    timestamp += movementTimeStepMs;
+    sendTouchRelease(timestamp, 0, touchPoint);
+}
+
+void tst_UCSwipeArea::earlyRecognition_data()
+{
+    QTest::addColumn<qreal>("speedFactor");
+    QTest::addColumn<bool>("recognized");
+
+    QTest::newRow("fast enough") << 0.5 << true;
+    QTest::newRow("too slow") << 2.0 << false;
+    QTest::newRow("disabled") << 0.0 << false;
+}
+
+/*
+    Without early recognition, which is the default, or with a touch point moving
+    slower than the early recognition speed, a gesture must only get recognized
+    once it crosses the distance threshold.
+ */
+void tst_UCSwipeArea::distanceRecognition()
+{
+    QFETCH(bool, enableEarlyRecognition);
+    QFETCH(qreal, speedFactor);
+
+    UCSwipeArea *edgeDragArea =
+        m_view->rootObject()->findChild<UCSwipeArea*>("hpDragArea");
+    QVERIFY(edgeDragArea != 0);
+    UCSwipeAreaPrivate *d = UCSwipeAreaPrivate::get(edgeDragArea);
+    d->setRecognitionTimer(m_fakeTimerFactory->createTimer(edgeDragArea));
+    d->setTimeSource(m_fakeTimerFactory->timeSource());
+    QCOMPARE(d->earlyRecognitionSpeed, 0.);
+
+    // Disable some constraints we're not interested in
+    d->setMaxTime(60 * 1000);
+
+    // In pixels per millisecond, speedFactor times what reaches the distance threshold at
+    // twice the composition time.
+    qreal speed = d->distanceThreshold / (d->compositionTime * 2.) * speedFactor;
+    if (enableEarlyRecognition) {
+        d->setEarlyRecognitionSpeed(speed * 1000. * 2.);
+    }
+
+    const QPointF initialTouchPoint = calculateInitialtouchPosition(edgeDragArea);
+    QPointF touchPoint = initialTouchPoint;
+    int movementTimeStepMs = 5;
+    QPointF touchMovement(speed * movementTimeStepMs, 0.);
+    qint64 timestamp = 0;
+
+    sendTouchPress(timestamp, 0, touchPoint);
+
+    while (touchPoint.x() + touchMovement.x() - initialTouchPoint.x() < d->distanceThreshold) {
+        touchPoint += touchMovement;
+        timestamp += movementTimeStepMs;
+        sendTouchUpdate(timestamp, 0, touchPoint);
+        QCOMPARE((int)d->status, (int)UCSwipeAreaPrivate::Undecided);
+    }
+    QVERIFY(timestamp > d->compositionTime);
+
+    touchPoint += touchMovement;
+    timestamp += movementTimeStepMs;
+    sendTouchUpdate(timestamp, 0, touchPoint);
+    QCOMPARE((int)d->status, (int)UCSwipeAreaPrivate::Recognized);
+
+    timestamp += movementTimeStepMs;
+    sendTouchRelease(timestamp, 0, touchPoint);
+}
+
+void tst_UCSwipeArea::distanceRecognition_data()
+{
+    QTest::addColumn<bool>("enableEarlyRecognition");
+    QTest::addColumn<qreal>("speedFactor");
+
+    QTest::newRow("default, fast drag") << false << 1.5;
+    QTest::newRow("default, slow drag") << false << 0.5;
+    QTest::newRow("enabled, slow drag") << true << 0.5;
+}
+
+/*
+    The earlyRecognition property enables early recognition at 50mm/s, following
+    the pixel density of the screen.
+ */
+void tst_UCSwipeArea::earlyRecognitionProperty()
+{
+    UCSwipeArea *edgeDragArea =
+        m_view->rootObject()->findChild<UCSwipeArea*>("hpDragArea");
+    QVERIFY(edgeDragArea != 0);
+    UCSwipeAreaPrivate *d = UCSwipeAreaPrivate::get(edgeDragArea);
+    QSignalSpy earlyRecognitionSpy(edgeDragArea, &UCSwipeArea::earlyRecognitionChanged);
+
+    QCOMPARE(edgeDragArea->earlyRecognition(), false);
+    QCOMPARE(d->earlyRecognitionSpeed, 0.);
+
+    d->setPixelsPerMm(4.);
+    QCOMPARE(d->earlyRecognitionSpeed, 0.);
+
+    edgeDragArea->setEarlyRecognition(true);
+    QCOMPARE(earlyRecognitionSpy.count(), 1);
+    QCOMPARE(d->earlyRecognitionSpeed, 200.);
+
+    edgeDragArea->setEarlyRecognition(true);
+    QCOMPARE(earlyRecognitionSpy.count(), 1);
+
+    d->setPixelsPerMm(6.);
+    QCOMPARE(d->earlyRecognitionSpeed, 300.);
+
+    edgeDragArea->setEarlyRecognition(false);
+    QCOMPARE(earlyRecognitionSpy.count(), 2);
+    QCOMPARE(d->earlyRecognitionSpeed, 0.);
+}
+
 QTEST_MAIN(tst_UCSwipeArea)
 
 #include "tst_swipearea.moc"
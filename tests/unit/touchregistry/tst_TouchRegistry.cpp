@@ -28,8 +28,10 @@ UG_NAMESPACE_BEGIN
 class TouchMemento {
 public:
     TouchMemento(const QTouchEvent *touchEvent);
+    TouchMemento(UnownedTouchEvent *unownedTouchEvent);
     Qt::TouchPointStates touchPointStates;
     QList<QTouchEvent::TouchPoint> touchPoints;
+    QHash<int, TouchHistory> history;
 
     bool containsTouchWithId(int touchId) const;
 };
@@ -74,6 +76,8 @@ private Q_SLOTS:
     void candidateVanishes();
     void candicateOwnershipReentrace();
     void touchReleaseWithoutPressDoesNotCrash();
+    void coalescesTouchUpdates();
+    void releaseFlushesCoalescedTouchUpdates();
 
 private:
     TouchRegistry *touchRegistry;
@@ -89,6 +93,25 @@ void tst_TouchRegistry::cleanup()
     delete touchRegistry;
 }
 
+namespace {
+void sendTouchEvent(TouchRegistry *touchRegistry, QEvent::Type type, Qt::TouchPointState state,
+                    const QPointF &pos, ulong timestamp)
+{
+    QList<QTouchEvent::TouchPoint> touchPoints;
+    touchPoints.append(QTouchEvent::TouchPoint(0));
+    touchPoints[0].setState(state);
+    touchPoints[0].setPos(pos);
+    touchPoints[0].setRect(QRectF(pos, QSizeF(0, 0)));
+    QTouchEvent touchEvent(type,
+                           0 /* device */,
+                           Qt::NoModifier,
+                           state,
+                           touchPoints);
+    touchEvent.setTimestamp(timestamp);
+    touchRegistry->update(&touchEvent);
+}
+} // namespace {
+
 void tst_TouchRegistry::requestWithNoCandidates()
 {
     DummyCandidate candidate;
@@ -933,6 +956,87 @@ void tst_TouchRegistry::touchReleaseWithoutPressDoesNotCrash() {
     touchRegistry->update(&touchEvent);
 }
 
+/*
+  Checks that, when coalescing, consecutive updates reach candidates and watchers as a single
+  UnownedTouchEvent once flushed, carrying every position the touch went through.
+ */
+void tst_TouchRegistry::coalescesTouchUpdates()
+{
+    QQuickItem rootItem;
+
+    DummyCandidate candidate;
+    candidate.setParentItem(&rootItem);
+    DummyCandidate watcher;
+    watcher.setParentItem(&rootItem);
+
+    touchRegistry->setCoalesceUpdates(true);
+
+    sendTouchEvent(touchRegistry, QEvent::TouchBegin, Qt::TouchPointPressed, QPointF(10, 10), 100);
+
+    touchRegistry->addCandidateOwnerForTouch(0, &candidate);
+    touchRegistry->addTouchWatcher(0, &watcher);
+
+    sendTouchEvent(touchRegistry, QEvent::TouchUpdate, Qt::TouchPointMoved, QPointF(11, 10), 105);
+    sendTouchEvent(touchRegistry, QEvent::TouchUpdate, Qt::TouchPointMoved, QPointF(13, 10), 110);
+    sendTouchEvent(touchRegistry, QEvent::TouchUpdate, Qt::TouchPointMoved, QPointF(16, 10), 115);
+
+    QCOMPARE(candidate.unownedTouchEvents.count(), 0);
+    QCOMPARE(watcher.unownedTouchEvents.count(), 0);
+
+    touchRegistry->flushPendingUpdates();
+
+    QCOMPARE(candidate.unownedTouchEvents.count(), 1);
+    QCOMPARE(watcher.unownedTouchEvents.count(), 1);
+
+    const TouchMemento &memento = candidate.unownedTouchEvents[0];
+    QCOMPARE(memento.touchPoints.count(), 1);
+    QCOMPARE(memento.touchPoints[0].id(), 0);
+    QCOMPARE(memento.touchPoints[0].state(), Qt::TouchPointMoved);
+    QCOMPARE(memento.touchPoints[0].scenePos(), QPointF(16, 10));
+
+    const TouchHistory history = memento.history.value(0);
+    QCOMPARE(history.count(), 3);
+    QCOMPARE(history[0].scenePos, QPointF(11, 10));
+    QCOMPARE(history[0].timestamp, (ulong)105);
+    QCOMPARE(history[1].scenePos, QPointF(13, 10));
+    QCOMPARE(history[2].scenePos, QPointF(16, 10));
+    QCOMPARE(history[2].timestamp, (ulong)115);
+
+    QCOMPARE(watcher.unownedTouchEvents[0].history.value(0).count(), 3);
+
+    // nothing left to deliver
+    touchRegistry->flushPendingUpdates();
+    QCOMPARE(candidate.unownedTouchEvents.count(), 1);
+}
+
+void tst_TouchRegistry::releaseFlushesCoalescedTouchUpdates()
+{
+    QQuickItem rootItem;
+
+    DummyCandidate candidate;
+    candidate.setParentItem(&rootItem);
+
+    touchRegistry->setCoalesceUpdates(true);
+
+    sendTouchEvent(touchRegistry, QEvent::TouchBegin, Qt::TouchPointPressed, QPointF(10, 10), 100);
+
+    touchRegistry->addCandidateOwnerForTouch(0, &candidate);
+
+    sendTouchEvent(touchRegistry, QEvent::TouchUpdate, Qt::TouchPointMoved, QPointF(11, 10), 105);
+    sendTouchEvent(touchRegistry, QEvent::TouchUpdate, Qt::TouchPointMoved, QPointF(13, 10), 110);
+
+    QCOMPARE(candidate.unownedTouchEvents.count(), 0);
+
+    sendTouchEvent(touchRegistry, QEvent::TouchEnd, Qt::TouchPointReleased, QPointF(13, 10), 115);
+
+    // the coalesced update must arrive before the release
+    QCOMPARE(candidate.unownedTouchEvents.count(), 2);
+    QCOMPARE(candidate.unownedTouchEvents[0].touchPointStates, Qt::TouchPointStates(Qt::TouchPointMoved));
+    QCOMPARE(candidate.unownedTouchEvents[0].history.value(0).count(), 2);
+    QCOMPARE(candidate.unownedTouchEvents[1].touchPointStates, Qt::TouchPointStates(Qt::TouchPointReleased));
+    QVERIFY(candidate.unownedTouchEvents[1].history.isEmpty());
+}
+
 ////////////// TouchMemento //////////
 
 TouchMemento::TouchMemento(const QTouchEvent *touchEvent)
@@ -940,6 +1044,17 @@ TouchMemento::TouchMemento(const QTouchEvent *touchEvent)
 {
 }
 
+TouchMemento::TouchMemento(UnownedTouchEvent *unownedTouchEvent)
+    : TouchMemento(unownedTouchEvent->touchEvent())
+{
+    for (int i = 0; i < touchPoints.count(); ++i) {
+        const TouchHistory touchHistory = unownedTouchEvent->history(touchPoints.at(i).id());
+        if (!touchHistory.isEmpty()) {
+            history.insert(touchPoints.at(i).id(), touchHistory);
+        }
+    }
+}
+
 bool TouchMemento::containsTouchWithId(int touchId) const
 {
     for (int i = 0; i < touchPoints.count(); ++i) {
@@ -974,7 +1089,7 @@ bool DummyCandidate::event(QEvent *e)
         return true;
     } else if (e->type() == UnownedTouchEvent::unownedTouchEventType()) {
         UnownedTouchEvent *unownedTouchEvent = static_cast<UnownedTouchEvent *>(e);
-        unownedTouchEvents.append(TouchMemento(unownedTouchEvent->touchEvent()));
+        unownedTouchEvents.append(TouchMemento(unownedTouchEvent));
         return true;
     } else {
         return QObject::event(e);
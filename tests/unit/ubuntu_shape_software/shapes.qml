@@ -0,0 +1,56 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+import Ubuntu.Components.Private 1.3
+
+Rectangle {
+    width: 500
+    height: 120
+    color: "white"
+
+    UbuntuShape {
+        x: 0; y: 0
+        width: 100; height: 100
+        aspect: UbuntuShape.Flat
+        backgroundColor: "red"
+    }
+
+    UbuntuShapeOverlay {
+        x: 120; y: 0
+        width: 100; height: 100
+        aspect: UbuntuShape.Flat
+        backgroundColor: "red"
+        overlayColor: "blue"
+        overlayRect: Qt.rect(0.0, 0.5, 1.0, 0.5)
+    }
+
+    ProportionalShape {
+        x: 240; y: 0
+        width: 100
+        aspect: UbuntuShape.Flat
+        backgroundColor: "lime"
+    }
+
+    Frame {
+        x: 360; y: 0
+        width: 100; height: 100
+        thickness: 10
+        radius: 20
+        color: "black"
+    }
+}
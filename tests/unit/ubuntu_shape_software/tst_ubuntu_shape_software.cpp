@@ -0,0 +1,93 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QSGRendererInterface>
+#include <QtTest/QtTest>
+
+// Renders the shapes with the software adaptation of the scene graph, checking the colors match
+// what the OpenGL materials render.
+class tst_UbuntuShapeSoftware: public QObject
+{
+    Q_OBJECT
+
+private:
+    QQuickView *m_quickView;
+    QImage m_result;
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        // Must be set before any window is created.
+        QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+
+        m_quickView = new QQuickView;
+        m_quickView->setGeometry(0, 0, 500, 120);
+
+        // add modules folder so we have access to the plugin from QML
+        QQmlEngine *engine = m_quickView->engine();
+        QString modules(UBUNTU_QML_IMPORT_PATH);
+        QStringList imports = engine->importPathList();
+        imports.prepend(QDir(modules).absolutePath());
+        engine->setImportPathList(imports);
+
+        m_quickView->setSource(QUrl::fromLocalFile("shapes.qml"));
+        QCOMPARE(m_quickView->status(), QQuickView::Ready);
+        m_quickView->show();
+        QVERIFY(QTest::qWaitForWindowExposed(m_quickView));
+        QCOMPARE(m_quickView->rendererInterface()->graphicsApi(), QSGRendererInterface::Software);
+
+        m_result = m_quickView->grabWindow();
+        QVERIFY(!m_result.isNull());
+        m_result = m_result.scaled(QSize(500, 120)).convertToFormat(QImage::Format_RGB32);
+    }
+
+    void cleanupTestCase()
+    {
+        delete m_quickView;
+    }
+
+    void pixels_data()
+    {
+        QTest::addColumn<QPoint>("position");
+        QTest::addColumn<QColor>("color");
+
+        QTest::newRow("shape center") << QPoint(50, 50) << QColor(Qt::red);
+        QTest::newRow("shape edge") << QPoint(50, 0) << QColor(Qt::red);
+        QTest::newRow("shape corner") << QPoint(0, 0) << QColor(Qt::white);
+        QTest::newRow("overlay background") << QPoint(170, 25) << QColor(Qt::red);
+        QTest::newRow("overlay rect") << QPoint(170, 75) << QColor(Qt::blue);
+        QTest::newRow("overlay corner") << QPoint(219, 99) << QColor(Qt::white);
+        QTest::newRow("proportional center") << QPoint(290, 50) << QColor(Qt::green);
+        QTest::newRow("proportional corner") << QPoint(240, 0) << QColor(Qt::white);
+        QTest::newRow("frame border") << QPoint(410, 5) << QColor(Qt::black);
+        QTest::newRow("frame inside") << QPoint(410, 50) << QColor(Qt::white);
+        QTest::newRow("frame corner") << QPoint(360, 0) << QColor(Qt::white);
+    }
+    void pixels()
+    {
+        QFETCH(QPoint, position);
+        QFETCH(QColor, color);
+
+        QCOMPARE(QColor(m_result.pixel(position)), color);
+    }
+};
+
+QTEST_MAIN(tst_UbuntuShapeSoftware)
+
+#include "tst_ubuntu_shape_software.moc"
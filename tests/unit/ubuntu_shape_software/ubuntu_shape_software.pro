@@ -0,0 +1,3 @@
+include(../test-include-x11.pri)
+SOURCES += tst_ubuntu_shape_software.cpp
+OTHER_FILES += shapes.qml
@@ -17,6 +17,7 @@ SUBDIRS += testparser
 SUBDIRS += \
     visual \
     ubuntu_shape \
+    ubuntu_shape_software \
     page \
     test \
     iconprovider \
@@ -48,4 +49,5 @@ SUBDIRS += \
     alarms \
     theme \
     quickutils \
-    tree
+    tree \
+    iconatlas
@@ -282,6 +282,28 @@ private Q_SLOTS:
         expected = QString("0.875/" + QDir::currentPath() + QDir::separator() + "resource@8.png");
         QCOMPARE(resolved, expected);
     }
+
+    void resolveAfterDirectoryChange() {
+        UCUnits units;
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        const QString path = directory.path() + QDir::separator();
+
+        QFile lower(path + "resource@8.png");
+        QVERIFY(lower.open(QIODevice::WriteOnly));
+        lower.close();
+
+        units.setGridUnit(10);
+        QCOMPARE(units.resolveResource(QUrl::fromLocalFile(path + "resource.png")),
+                 QString("1.25/" + path + "resource@8.png"));
+
+        // the directory index is refreshed once a better variant appears
+        QFile exact(path + "resource@10.png");
+        QVERIFY(exact.open(QIODevice::WriteOnly));
+        exact.close();
+        QTRY_COMPARE(units.resolveResource(QUrl::fromLocalFile(path + "resource.png")),
+                     QString("1/" + path + "resource@10.png"));
+    }
 };
 
 QTEST_MAIN(tst_UCUnits)
@@ -121,6 +121,7 @@ Item {
             compare(shader.keyColorOut, icon.color);
             compare(shader.visible, true);
             compare(shader.source, image);
+            compare(shader.supportsAtlasTextures, true);
             icon.keyColor = UbuntuColors.purple;
             compare(shader.keyColorIn, icon.keyColor);
             // Unsetting the icon name should disable the shader
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import QtTest 1.0
+import Ubuntu.Components 1.3
+import Ubuntu.Test 1.3
+
+Item {
+    width: units.gu(50)
+    height: units.gu(50)
+
+    // loaded asynchronously, the images are ready right away only when cached
+    Image {
+        id: image
+        width: units.gu(10)
+        height: units.gu(10)
+        asynchronous: true
+    }
+
+    // requests images as Icon does
+    Image {
+        id: iconImage
+        width: units.gu(4)
+        height: units.gu(4)
+        fillMode: Image.PreserveAspectFit
+        sourceSize {
+            width: iconImage.width
+            height: iconImage.height
+        }
+        asynchronous: true
+    }
+    Image {
+        id: otherIconImage
+        width: units.gu(5)
+        height: units.gu(5)
+        fillMode: Image.PreserveAspectFit
+        sourceSize {
+            width: otherIconImage.width
+            height: otherIconImage.height
+        }
+        asynchronous: true
+    }
+
+    UbuntuTestCase {
+        name: "ImageCache"
+        when: windowShown
+
+        SignalSpy {
+            id: finishedSpy
+            target: ImageCache
+            signalName: "finished"
+        }
+
+        SignalSpy {
+            id: cancelledSpy
+            target: ImageCache
+            signalName: "cancelled"
+        }
+
+        function cleanup() {
+            ImageCache.clear();
+            image.source = "";
+            iconImage.source = "";
+            otherIconImage.source = "";
+            finishedSpy.clear();
+            cancelledSpy.clear();
+        }
+
+        function test_prefetch() {
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png"),
+                                 Qt.resolvedUrl("battery-100-charging.svg"),
+                                 Qt.resolvedUrl("nonexistent.png")]);
+            verify(ImageCache.running);
+            finishedSpy.wait();
+            verify(!ImageCache.running);
+            compare(ImageCache.progress, 1.0);
+            compare(ImageCache.count, 2);
+
+            // the cached image is shown right away
+            image.source = Qt.resolvedUrl("tst_icon-select.png");
+            compare(image.status, Image.Ready);
+        }
+
+        function test_prefetchIconSize() {
+            ImageCache.prefetch([Qt.resolvedUrl("battery-100-charging.svg")],
+                                Qt.size(iconImage.width, iconImage.height), Image.PreserveAspectFit);
+            finishedSpy.wait();
+            compare(ImageCache.count, 1);
+
+            iconImage.source = Qt.resolvedUrl("battery-100-charging.svg");
+            compare(iconImage.status, Image.Ready, "prefetched image not found in the cache");
+        }
+
+        function test_prefetchFillModeMismatch() {
+            // same size, but not the options the item requests the image with
+            ImageCache.prefetch([Qt.resolvedUrl("battery-100-charging.svg")],
+                                Qt.size(otherIconImage.width, otherIconImage.height));
+            finishedSpy.wait();
+            compare(ImageCache.count, 1);
+
+            otherIconImage.source = Qt.resolvedUrl("battery-100-charging.svg");
+            compare(otherIconImage.status, Image.Loading, "image found in the cache with other options");
+            tryCompare(otherIconImage, "status", Image.Ready);
+        }
+
+        function test_prefetchTwice() {
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png")]);
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png")]);
+            finishedSpy.wait();
+            compare(finishedSpy.count, 1);
+            compare(ImageCache.count, 1);
+        }
+
+        function test_cancel() {
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png")]);
+            ImageCache.cancel();
+            compare(cancelledSpy.count, 1);
+            verify(!ImageCache.running);
+            compare(ImageCache.count, 0);
+        }
+
+        function test_prefetchCancelPrefetch() {
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png")]);
+            finishedSpy.wait();
+            compare(ImageCache.count, 1);
+
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png"),
+                                 Qt.resolvedUrl("battery-100-charging.svg")]);
+            ImageCache.cancel();
+            compare(cancelledSpy.count, 1);
+            compare(ImageCache.count, 1);
+
+            // the prefetched image is kept once, the cancelled one is prefetched again
+            ImageCache.prefetch([Qt.resolvedUrl("tst_icon-select.png"),
+                                 Qt.resolvedUrl("battery-100-charging.svg")]);
+            verify(ImageCache.running);
+            finishedSpy.wait();
+            compare(finishedSpy.count, 2);
+            compare(ImageCache.count, 2);
+        }
+    }
+}
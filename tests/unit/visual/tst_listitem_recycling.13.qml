@@ -0,0 +1,199 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+import QtQuick 2.4
+import QtTest 1.0
+import Ubuntu.Test 1.3
+import Ubuntu.Components 1.3
+
+Item {
+    id: main
+    width: units.gu(50)
+    height: units.gu(40)
+
+    Action {
+        id: trailingAction
+        objectName: "trailingAction"
+        iconName: "delete"
+    }
+    ListItemActions {
+        id: trailingActions
+        actions: [trailingAction]
+    }
+
+    Column {
+        id: plainColumn
+        width: parent.width
+        height: units.gu(20)
+    }
+    Column {
+        id: selectColumn
+        y: units.gu(20)
+        width: parent.width
+        height: units.gu(20)
+        ViewItems.selectMode: true
+    }
+
+    Component {
+        id: listItemComponent
+        ListItem {
+            trailingActions: trailingActions
+            Label {
+                text: "Recycled style"
+            }
+        }
+    }
+
+    ListItemTestCase13 {
+        name: "ListItemStyleRecycling"
+
+        SignalSpy {
+            id: actionSpy
+            target: trailingAction
+            signalName: "triggered"
+        }
+        SignalSpy {
+            id: styleSpy
+        }
+
+        function cleanup() {
+            actionSpy.clear();
+            styleSpy.clear();
+            styleSpy.target = null;
+        }
+
+        function waitForStyle(item) {
+            tryCompareFunction(function() { return item.__styleInstance !== null; }, true);
+        }
+
+        // destroys the item, and returns the style it left for reuse
+        function recycle(item) {
+            var style = item.__styleInstance;
+            verify(style, "the item has no style to recycle");
+            item.destroy();
+            // recycled on deferred deletion
+            wait(50);
+            return style;
+        }
+
+        function swipeTrailing(item) {
+            swipe(item, centerOf(item).x, centerOf(item).y, -units.gu(20), 0);
+            verify(item.contentItem.x < 0, "trailing actions not revealed");
+        }
+
+        function loader(item, leading) {
+            return findInvisibleChild(item, leading ? "leading_loader" : "trailing_loader");
+        }
+
+        function test_selected_style_reused_by_swiped_item() {
+            var selected = listItemComponent.createObject(selectColumn);
+            waitForStyle(selected);
+            selected.selected = true;
+            var checkbox = findChild(selected, "listitem_select");
+            verify(checkbox);
+            tryCompare(checkbox, "checked", true);
+            var style = recycle(selected);
+
+            var swiped = listItemComponent.createObject(plainColumn);
+            // the style is loaded on swipe
+            swipeTrailing(swiped);
+            compare(swiped.__styleInstance, style, "style not recycled");
+            compare(swiped.selected, false, "selection leaked into the new item");
+            compare(swiped.contentItem.anchors.leftMargin, 0, "selection panel margin leaked");
+            compare(loader(swiped, true).item, null, "selection panel kept");
+            verify(panelItem(swiped, false), "actions panel not loaded");
+            verify(findChild(panelItem(swiped, false), "actionbutton_trailingAction"));
+
+            rebound(swiped);
+            swiped.destroy();
+        }
+
+        function test_swiped_style_reused_by_selected_item() {
+            var swiped = listItemComponent.createObject(plainColumn);
+            swipeTrailing(swiped);
+            // select the action, and destroy the item while snapping out
+            var button = findChild(panelItem(swiped, false), "actionbutton_trailingAction");
+            verify(button);
+            mouseClick(button, centerOf(button).x, centerOf(button).y);
+            var style = recycle(swiped);
+            compare(style.snapAnimation.running, false, "snap animation left running");
+            compare(actionSpy.count, 0, "action of the destroyed item triggered");
+
+            var selected = listItemComponent.createObject(selectColumn);
+            waitForStyle(selected);
+            compare(selected.__styleInstance, style, "style not recycled");
+            compare(selected.contentItem.x, selected.contentItem.anchors.leftMargin, "swipe state leaked");
+            compare(loader(selected, false).item, null, "actions panel kept");
+            var checkbox = findChild(selected, "listitem_select");
+            verify(checkbox, "selection panel not loaded");
+            compare(checkbox.checked, false);
+            compare(selected.selected, false);
+
+            // a swipe on the new item does not trigger the previously selected action
+            selectColumn.ViewItems.selectMode = false;
+            wait(400);
+            swipeTrailing(selected);
+            rebound(selected);
+            compare(actionSpy.count, 0, "action selected on the destroyed item triggered");
+
+            selectColumn.ViewItems.selectMode = true;
+            selected.destroy();
+        }
+
+        function test_parked_style_handlers_blocked() {
+            var swiped = listItemComponent.createObject(plainColumn);
+            swipeTrailing(swiped);
+            var style = recycle(swiped);
+
+            // onXChanged of the style would update the snapping of the destroyed item
+            styleSpy.target = style;
+            styleSpy.signalName = "xChanged";
+            style.x = units.gu(5);
+            compare(styleSpy.count, 0, "handler of the parked style run");
+            style.x = 0;
+
+            // handlers run again once reused
+            var reused = listItemComponent.createObject(plainColumn);
+            styleSpy.target = style.snapAnimation;
+            styleSpy.signalName = "runningChanged";
+            swipeTrailing(reused);
+            compare(reused.__styleInstance, style, "style not recycled");
+            rebound(reused);
+            verify(styleSpy.count > 0, "handlers of the reused style blocked");
+            reused.destroy();
+        }
+
+        function test_style_reused_within_selection() {
+            var first = listItemComponent.createObject(selectColumn);
+            waitForStyle(first);
+            var checkbox = findChild(first, "listitem_select");
+            // user toggle
+            mouseClick(checkbox, centerOf(checkbox).x, centerOf(checkbox).y);
+            compare(first.selected, true);
+            var style = recycle(first);
+
+            var second = listItemComponent.createObject(selectColumn);
+            waitForStyle(second);
+            compare(second.__styleInstance, style, "style not recycled");
+            checkbox = findChild(second, "listitem_select");
+            verify(checkbox);
+            compare(checkbox.checked, false, "checkbox state leaked");
+            compare(second.selected, false, "selection written into the new item");
+            second.destroy();
+        }
+    }
+}